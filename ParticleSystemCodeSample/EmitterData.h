@@ -10,10 +10,27 @@ data that the client defines in the editor.
 ******************************************************************************************/
 #pragma once
 
+#include <memory>
 #include <vector>
 #include "../../../Math/Vector4.h"
 #include "../Renderer/Renderer.h"
 
+/*!*************************************************************************************
+\par struct: emitterLOD
+\brief   How much detail an emitter keeps from a camera distance on. Closer than the
+  first tier an emitter runs at full detail.
+
+\par baseClass: true
+***************************************************************************************/
+struct emitterLOD
+{
+  float m_distance;          //!< camera distance the tier starts at
+  float m_spawnRateScale;    //!< scale for m_particlesPerSecond
+  float m_particleCapScale;  //!< scale for m_numberofParticles (particles over the cap aren't killed, just not replaced)
+  unsigned m_updateInterval; //!< number of frames between updates (1 to update every frame)
+  bool m_collides;           //!< if the particles still check colliders
+};
+
 /*!*************************************************************************************
 \par struct: emitterData
 \brief   This is all the data required to create the particle emitters. Most of this
@@ -39,7 +56,8 @@ struct emitterData
     m_constantAcceleration(constantAcceleration), m_particlesPerSecond(pParticlesPerSecond), m_offset(pOffset), m_initialAngle(pInitialAngle),
     m_randomAngleRange(pRandomAng), m_randomPositionRange(pRandomPos), m_particleRenderer(pRenderer), m_randomParticleLifetimeRange(prandomParticleLifetime),
     m_waveOnTime(pWaveOntime), m_waveOffTime(pWaveOffTime), m_startOnTrigger(pStartOnTrigger), m_isInteractable(isInteractable), m_randomScaleFactor(randomScale), 
-    m_particleRestistution(particleRestitution), m_interactsWithSelf(selfInteracting), m_isRemoved(false)
+    m_particleRestistution(particleRestitution), m_interactsWithSelf(selfInteracting), m_isRemoved(false), m_randomSeed(0), m_useExactCollisions(false),
+    m_lodBlendDistance(0.0f), m_fixedTimeStep(0.0f), m_maxSubsteps(4), m_useAnalyticMotion(false)
   {
   }
 
@@ -81,4 +99,19 @@ struct emitterData
   float m_particleRestistution; //!< "bouncyness" of the particles
 
   bool m_isRemoved; //!< (mainly editor stuff) bool used by emitter bundle to remove for itself.
+
+  unsigned m_randomSeed; //!< seed for the random values of the particles (0 to get a unique one)
+  bool m_useExactCollisions; //!< checks the faces of colliders even if they were baked into a distance field
+
+  std::vector<emitterLOD> m_lodTiers; //!< detail tiers sorted by distance (empty to always run at full detail)
+  float m_lodBlendDistance;           //!< distance over which spawn rate and particle cap fade into a tier
+
+  float m_fixedTimeStep;  //!< time the particles are simulated in steps of (0 to step with the frame time)
+  unsigned m_maxSubsteps; //!< most fixed steps taken in a frame, the time past them is dropped
+
+  bool m_useAnalyticMotion; //!< evaluates particles that don't collide in closed form instead of integrating them (see particleEmitter::IsAnalytic)
 };
+
+  // an emitter definition placed lots of times (by particleInstancedEmitter) is shared by
+  // all of its placements and never changes while they're alive
+typedef std::shared_ptr<const emitterData> emitterDefinition;
@@ -10,63 +10,121 @@ This is the implementation for the particle class.
 
 #include "Particle.h"
 
-particle::particle(unsigned int pGPUData) :
-  m_particleGPUDataIndex(pGPUData), m_currentLifetime(0.0f), m_angularVelocity(0.0f), isActive(false), m_totalLifetime(0.0f)
+particle::particle(particleStorage& pStorage, unsigned int pIndex) :
+  m_storage(&pStorage), m_index(pIndex)
 {
 }
 
 float& particle::GetCurrentLifetime()
 {
-  return m_currentLifetime;
+  return m_storage->m_currentLifetime[m_index];
 }
 
-unsigned int& particle::GetGPUData()
+unsigned int particle::GetGPUData() const
 {
-  return m_particleGPUDataIndex;
+  return m_index;
 }
 
 void particle::SetVelocity(const vector4& pVelocity)
 {
-  m_velocity.x = pVelocity.x;
-  m_velocity.y = pVelocity.y;
+  m_storage->m_velocityX[m_index] = pVelocity.x;
+  m_storage->m_velocityY[m_index] = pVelocity.y;
 }
 
 vector4 particle::GetVelocity() const
 {
-  return m_velocity;
+  return vector4(m_storage->m_velocityX[m_index], m_storage->m_velocityY[m_index]);
 }
 
 void particle::SetAngularVelocity(float pAngVelocity)
 {
-  m_angularVelocity = pAngVelocity;
+  m_storage->m_angularVelocity[m_index] = pAngVelocity;
 }
 
 float particle::GetAngularVelocity() const
 {
-  return m_angularVelocity;
+  return m_storage->m_angularVelocity[m_index];
 }
 
 bool particle::IsActive() const
 {
-  return isActive;
+  return m_storage->m_isActive[m_index] != 0;
 }
 
 void particle::SetActive(bool pisActive)
 {
-  isActive = pisActive;
+  m_storage->m_isActive[m_index] = pisActive;
 }
 
 float& particle::GetTotalLifetime()
 {
-  return m_totalLifetime;
+  return m_storage->m_totalLifetime[m_index];
 }
 
 float* particle::GetRandomScale()
 {
-  return m_randomScaleFactor;
+  return &m_storage->m_randomScale[m_index * 2];
 }
 
-vector4& particle::GetForce()
+vector4 particle::GetForce() const
 {
-  return m_force;
+  return vector4(m_storage->m_forceX[m_index], m_storage->m_forceY[m_index]);
+}
+
+void particle::AddForce(const vector4& pForce)
+{
+  m_storage->m_forceX[m_index] += pForce.x;
+  m_storage->m_forceY[m_index] += pForce.y;
+}
+
+void particle::ClearForce()
+{
+  m_storage->m_forceX[m_index] = 0.0f;
+  m_storage->m_forceY[m_index] = 0.0f;
+}
+
+vector4 particle::GetOldPosition() const
+{
+  return vector4(m_storage->m_oldPositionX[m_index], m_storage->m_oldPositionY[m_index], m_storage->m_positionZ[m_index]);
+}
+
+void particle::SetOldPosition(const vector4& pOldPosition)
+{
+  m_storage->m_oldPositionX[m_index] = pOldPosition.x;
+  m_storage->m_oldPositionY[m_index] = pOldPosition.y;
+}
+
+vector4 particle::GetPosition() const
+{
+  return vector4(m_storage->m_positionX[m_index], m_storage->m_positionY[m_index], m_storage->m_positionZ[m_index]);
+}
+
+void particle::SetPosition(const vector4& pPosition)
+{
+  m_storage->m_positionX[m_index] = pPosition.x;
+  m_storage->m_positionY[m_index] = pPosition.y;
+  m_storage->m_positionZ[m_index] = pPosition.z;
+}
+
+float& particle::GetRotation()
+{
+  return m_storage->m_rotation[m_index];
+}
+
+float& particle::GetScale()
+{
+  return m_storage->m_scale[m_index];
+}
+
+vector4 particle::GetColor() const
+{
+  return vector4(m_storage->m_colorR[m_index], m_storage->m_colorG[m_index], m_storage->m_colorB[m_index], m_storage->m_colorA[m_index]);
+}
+
+void particle::SetColor(const vector4& pColor)
+{
+  m_storage->m_colorR[m_index] = pColor.x;
+  m_storage->m_colorG[m_index] = pColor.y;
+  m_storage->m_colorB[m_index] = pColor.z;
+  m_storage->m_colorA[m_index] = pColor.w;
 }
@@ -5,16 +5,18 @@
 \copyright  All content � 2017-2018 DigiPen (USA) Corporation, all rights reserved.
 \par        Project: Field Punk
 \brief
-This is the implementation for the particle class. A lightweight class that whose data
-is managed by a particle emitter.
+This is the implementation for the particle class. A lightweight view of a single particle
+whose data is stored in the emitter's particle storage.
 ******************************************************************************************/
 #pragma once
 #include "ParticleEmitter.h"
+#include "ParticleStorage.h"
 
 /*!*************************************************************************************
 \par class: particle
 
-\brief  class for a single particle. Super lightweight
+\brief  class for a single particle. Super lightweight, it only refers to an index in
+        the particle storage of the emitter, so it can be created and thrown away freely
 \par baseClass: true
 ***************************************************************************************/
 class particle
@@ -23,10 +25,11 @@ public:
   /*!***********************************************************************************
   \brief  constructor for the particle
 
-  \param pGPUData - index of the gpud data the particle relates to in the emitter data's
-         vector of gpu data
+  \param pStorage - particle storage of the emitter the particle belongs to
+  \param pIndex - index of the particle in the storage (also the index of the gpu data
+         the particle relates to in the emitter's vector of gpu data)
   *************************************************************************************/
-  particle(unsigned int pGPUData);
+  particle(particleStorage& pStorage, unsigned int pIndex);
    
   /*!***********************************************************************************
   \brief  Gets the particle's current lifetime
@@ -38,9 +41,9 @@ public:
   /*!***********************************************************************************
   \brief  Gets the particle's index of the gpu data
 
-  \return m_particleGPUDataIndex
+  \return m_index
   *************************************************************************************/
-  unsigned int& GetGPUData();
+  unsigned int GetGPUData() const;
 
   /*!***********************************************************************************
   \brief  sets the new velocity after update
@@ -92,32 +95,88 @@ public:
   float& GetTotalLifetime();
 
   /*!***********************************************************************************
-  \brief  returns the total lifetime of the particle
+  \brief  returns the random initial and final scale of the particle
 
-  \return m_totalLifetime - total lifetime of the particle
+  \return pointer to the pair of scales (initial, final)
   *************************************************************************************/
   float *GetRandomScale();
 
   /*!***********************************************************************************
-  \brief  returns the total lifetime of the particle
+  \brief  returns the force of the individual particle
 
-  \return m_totalLifetime - total lifetime of the particle
+  \return force of the particle
   *************************************************************************************/
-  vector4& GetForce();
+  vector4 GetForce() const;
 
-  vector4& GetOldPosition() { return m_oldPosition;  }
+  /*!***********************************************************************************
+  \brief  adds force to the individual particle (cleared every physics update)
 
-private:
-  bool isActive; //!< bool determining if the particle is active or not
+  \param pForce - force to add
+  *************************************************************************************/
+  void AddForce(const vector4& pForce);
 
-    //!< index corresponding to gpu data in emitter's vector of gpu data
-  unsigned int m_particleGPUDataIndex; 
-  
-  float m_totalLifetime;   //!< total lifetime of the particle
-  float m_currentLifetime; //!< particle's current lifetime
-  float m_angularVelocity; //!< current angular velocity of particle
-  float m_randomScaleFactor[2]; //!< random scale factor for initial and final scale
-  vector4 m_velocity;      //!< current velocity of the particle
-  vector4 m_oldPosition;   //!< old position of the particle
-  vector4 m_force;         //!< force of individual particle
+  /*!***********************************************************************************
+  \brief  clears the force of the individual particle
+  *************************************************************************************/
+  void ClearForce();
+
+  /*!***********************************************************************************
+  \brief  returns the position of the particle before the last physics update
+
+  \return old position
+  *************************************************************************************/
+  vector4 GetOldPosition() const;
+
+  /*!***********************************************************************************
+  \brief  sets the position of the particle before the last physics update
+
+  \param pOldPosition - old position
+  *************************************************************************************/
+  void SetOldPosition(const vector4& pOldPosition);
+
+  /*!***********************************************************************************
+  \brief  returns the current position of the particle
+
+  \return position
+  *************************************************************************************/
+  vector4 GetPosition() const;
+
+  /*!***********************************************************************************
+  \brief  sets the current position of the particle
+
+  \param pPosition - position
+  *************************************************************************************/
+  void SetPosition(const vector4& pPosition);
+
+  /*!***********************************************************************************
+  \brief  returns the current rotation of the particle
+
+  \return rotation
+  *************************************************************************************/
+  float& GetRotation();
+
+  /*!***********************************************************************************
+  \brief  returns the current scale of the particle
+
+  \return scale
+  *************************************************************************************/
+  float& GetScale();
+
+  /*!***********************************************************************************
+  \brief  returns the current color of the particle
+
+  \return color
+  *************************************************************************************/
+  vector4 GetColor() const;
+
+  /*!***********************************************************************************
+  \brief  sets the current color of the particle
+
+  \param pColor - color
+  *************************************************************************************/
+  void SetColor(const vector4& pColor);
+
+private:
+  particleStorage* m_storage; //!< storage of the emitter holding the particle's data
+  unsigned int m_index;       //!< index of the particle in every array of the storage
 };
@@ -0,0 +1,133 @@
+/*!****************************************************************************************
+\file       ParticleArena.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particleArena class.
+******************************************************************************************/
+
+#include "ParticleArena.h"
+#include <cstdint>
+#include <new>
+
+particleArena::particleArena(std::size_t pPageSize) :
+  m_pageCursor(nullptr), m_pageRemaining(0), m_pageSize(pPageSize), m_reservedBytes(0), m_usedBytes(0)
+{
+  for (unsigned i = 0; i < c_sizeClassCount; ++i)
+    m_freeBlocks[i] = nullptr;
+}
+
+particleArena::~particleArena()
+{
+  for (void* page : m_pages)
+    ::operator delete(page);
+}
+
+void* particleArena::Allocate(std::size_t pSize)
+{
+  if (!pSize)
+    return nullptr;
+
+  unsigned sizeClass = GetSizeClass(pSize);
+  std::size_t blockSize = std::size_t(1) << (sizeClass + c_minimumShift);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_usedBytes += blockSize;
+
+    // reusing a block of the same size if one was given back
+  if (m_freeBlocks[sizeClass])
+  {
+    freeBlock* block = m_freeBlocks[sizeClass];
+    m_freeBlocks[sizeClass] = block->m_next;
+    return block;
+  }
+
+    // blocks bigger than a page get their own
+  if (blockSize > m_pageSize)
+    return AllocatePage(blockSize);
+
+  if (m_pageRemaining < blockSize)
+  {
+      // the rest of the current page is split into smaller blocks, so nothing is wasted
+    while (m_pageRemaining >= (std::size_t(1) << c_minimumShift))
+    {
+      unsigned leftoverClass = GetSizeClass(m_pageRemaining);
+      if ((std::size_t(1) << (leftoverClass + c_minimumShift)) > m_pageRemaining)
+        --leftoverClass;
+
+      std::size_t leftoverSize = std::size_t(1) << (leftoverClass + c_minimumShift);
+      PushFreeBlock(m_pageCursor, leftoverClass);
+      m_pageCursor += leftoverSize;
+      m_pageRemaining -= leftoverSize;
+    }
+
+    m_pageCursor = AllocatePage(m_pageSize);
+    m_pageRemaining = m_pageSize;
+  }
+
+  void* block = m_pageCursor;
+  m_pageCursor += blockSize;
+  m_pageRemaining -= blockSize;
+  return block;
+}
+
+void particleArena::Free(void* pBlock, std::size_t pSize)
+{
+  if (!pBlock)
+    return;
+
+  unsigned sizeClass = GetSizeClass(pSize);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_usedBytes -= std::size_t(1) << (sizeClass + c_minimumShift);
+  PushFreeBlock(pBlock, sizeClass);
+}
+
+std::size_t particleArena::GetReservedBytes() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_reservedBytes;
+}
+
+std::size_t particleArena::GetUsedBytes() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_usedBytes;
+}
+
+particleArena& particleArena::GetGlobalArena()
+{
+  static particleArena globalArena;
+  return globalArena;
+}
+
+unsigned particleArena::GetSizeClass(std::size_t pSize)
+{
+    // smallest power of two that fits the size
+  unsigned sizeClass = 0;
+  while ((std::size_t(1) << (sizeClass + c_minimumShift)) < pSize)
+    ++sizeClass;
+
+  return sizeClass;
+}
+
+char* particleArena::AllocatePage(std::size_t pSize)
+{
+    // over allocating so the page can be aligned
+  void* page = ::operator new(pSize + c_alignment);
+  m_pages.push_back(page);
+  m_reservedBytes += pSize + c_alignment;
+
+  std::uintptr_t address = reinterpret_cast<std::uintptr_t>(page);
+  address = (address + c_alignment - 1) & ~std::uintptr_t(c_alignment - 1);
+  return reinterpret_cast<char*>(address);
+}
+
+void particleArena::PushFreeBlock(void* pBlock, unsigned pSizeClass)
+{
+  freeBlock* block = static_cast<freeBlock*>(pBlock);
+  block->m_next = m_freeBlocks[pSizeClass];
+  m_freeBlocks[pSizeClass] = block;
+}
@@ -0,0 +1,184 @@
+/*!****************************************************************************************
+\file       ParticleArena.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particleArena class. Particle emitters get all of their
+memory from an arena, so creating and destroying emitters doesn't go to the heap once
+the arena has warmed up.
+******************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/*!*************************************************************************************
+\par class: particleArena
+
+\brief  Allocator for blocks of particle memory. Blocks are rounded up to a power of two
+        and carved out of big pages. Freed blocks go on a free list for their size, so
+        the next emitter asking for the same size reuses them and the memory doesn't
+        fragment. Pages are only given back to the heap when the arena is destroyed.
+        Every block is aligned to a cache line.
+\par baseClass: true
+***************************************************************************************/
+class particleArena
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for the arena
+
+  \param pPageSize - size of the pages blocks are carved out of (bigger blocks get a
+         page of their own)
+  *************************************************************************************/
+  explicit particleArena(std::size_t pPageSize = 1 << 20);
+
+  /*!***********************************************************************************
+  \brief  destructor for the arena, gives all pages back to the heap
+  *************************************************************************************/
+  ~particleArena();
+
+  particleArena(const particleArena&) = delete;
+  particleArena& operator=(const particleArena&) = delete;
+
+  /*!***********************************************************************************
+  \brief  Allocates a block of memory
+
+  \param pSize - size of the block in bytes
+  \return cache line aligned block (nullptr if pSize is 0)
+  *************************************************************************************/
+  void* Allocate(std::size_t pSize);
+
+  /*!***********************************************************************************
+  \brief  Gives a block back to the arena
+
+  \param pBlock - block to give back (allocated by this arena)
+  \param pSize - size the block was allocated with
+  *************************************************************************************/
+  void Free(void* pBlock, std::size_t pSize);
+
+  /*!***********************************************************************************
+  \brief  Gets how much memory the arena took from the heap
+
+  \return bytes taken from the heap
+  *************************************************************************************/
+  std::size_t GetReservedBytes() const;
+
+  /*!***********************************************************************************
+  \brief  Gets how much memory is currently handed out to emitters
+
+  \return bytes in use (rounded up to the block sizes)
+  *************************************************************************************/
+  std::size_t GetUsedBytes() const;
+
+  /*!***********************************************************************************
+  \brief  Gets the arena shared by all emitters that weren't given one
+
+  \return global arena
+  *************************************************************************************/
+  static particleArena& GetGlobalArena();
+
+  static const std::size_t c_alignment = 64; //!< alignment of every block (a cache line)
+
+private:
+  /*!***********************************************************************************
+  \brief  a free block, the link to the next one is stored in the block itself
+  *************************************************************************************/
+  struct freeBlock
+  {
+    freeBlock* m_next; //!< next free block of the same size
+  };
+
+  /*!***********************************************************************************
+  \brief  Gets the size class of a block (blocks of class i are 2^(i + c_minimumShift))
+
+  \param pSize - size of the block in bytes
+  \return size class
+  *************************************************************************************/
+  static unsigned GetSizeClass(std::size_t pSize);
+
+  /*!***********************************************************************************
+  \brief  Gets memory straight from the heap and remembers it for the destructor
+
+  \param pSize - size in bytes
+  \return cache line aligned memory
+  *************************************************************************************/
+  char* AllocatePage(std::size_t pSize);
+
+  /*!***********************************************************************************
+  \brief  Puts a block on the free list of its size class
+
+  \param pBlock - block to put on the list
+  \param pSizeClass - size class of the block
+  *************************************************************************************/
+  void PushFreeBlock(void* pBlock, unsigned pSizeClass);
+
+  static const unsigned c_minimumShift = 6;    //!< smallest block is 2^6 bytes
+  static const unsigned c_sizeClassCount = 32; //!< number of block sizes
+
+  mutable std::mutex m_mutex;                    //!< arena can be shared between threads
+  freeBlock* m_freeBlocks[c_sizeClassCount];     //!< free list for every block size
+  std::vector<void*> m_pages;                    //!< memory taken from the heap (unaligned)
+  char* m_pageCursor;                            //!< next unused byte in the current page
+  std::size_t m_pageRemaining;                   //!< bytes left in the current page
+  std::size_t m_pageSize;                        //!< size of a page
+  std::size_t m_reservedBytes;                   //!< bytes taken from the heap
+  std::size_t m_usedBytes;                       //!< bytes handed out
+};
+
+/*!*************************************************************************************
+\par class: particleArenaAllocator
+
+\brief  Standard library allocator handing out memory from a particle arena, so
+        containers of an emitter can live in the arena as well
+\par baseClass: true
+***************************************************************************************/
+template <typename T>
+class particleArenaAllocator
+{
+public:
+  typedef T value_type;
+
+  /*!***********************************************************************************
+  \brief  constructor for the allocator
+
+  \param pArena - arena to allocate from
+  *************************************************************************************/
+  particleArenaAllocator(particleArena* pArena = &particleArena::GetGlobalArena()) : m_arena(pArena)
+  {
+  }
+
+  /*!***********************************************************************************
+  \brief  converting constructor (used by containers for their internal types)
+  *************************************************************************************/
+  template <typename U>
+  particleArenaAllocator(const particleArenaAllocator<U>& pOther) : m_arena(pOther.m_arena)
+  {
+  }
+
+  T* allocate(std::size_t pCount)
+  {
+    return static_cast<T*>(m_arena->Allocate(pCount * sizeof(T)));
+  }
+
+  void deallocate(T* pBlock, std::size_t pCount)
+  {
+    m_arena->Free(pBlock, pCount * sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const particleArenaAllocator<U>& pOther) const
+  {
+    return m_arena == pOther.m_arena;
+  }
+
+  template <typename U>
+  bool operator!=(const particleArenaAllocator<U>& pOther) const
+  {
+    return m_arena != pOther.m_arena;
+  }
+
+  particleArena* m_arena; //!< arena the memory comes from
+};
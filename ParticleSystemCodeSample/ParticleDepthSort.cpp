@@ -0,0 +1,258 @@
+/*!****************************************************************************************
+\file       ParticleDepthSort.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particleDepthSort class.
+******************************************************************************************/
+
+#include "ParticleDepthSort.h"
+#include "ParticleStorage.h"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+  const unsigned c_noParticle = 0xFFFFFFFFu;    //!< marks a slot whose particle was overwritten
+  const unsigned c_maxShiftsPerParticle = 2;    //!< insertion sort gives up after this many shifts per particle
+
+  /*!***********************************************************************************
+  \brief  if a key is further back than another. Only the depth is compared, so
+          particles at the same depth stay in the order they were in
+  *************************************************************************************/
+  bool IsBehind(std::uint64_t pKey, std::uint64_t pOther)
+  {
+    return (pKey >> 32) < (pOther >> 32);
+  }
+
+  /*!***********************************************************************************
+  \brief  index of a particle's gpu data from its index in the storage (c_noParticle if
+          it isn't active)
+  *************************************************************************************/
+  unsigned GetGPUIndex(unsigned pStorageIndex, const particleSpan* pSpans, unsigned pSpanCount)
+  {
+    unsigned offset = 0;
+    for (unsigned span = 0; span < pSpanCount; ++span)
+    {
+      if ((pStorageIndex >= pSpans[span].m_begin) && (pStorageIndex < pSpans[span].m_end))
+        return offset + pStorageIndex - pSpans[span].m_begin;
+
+      offset += pSpans[span].m_end - pSpans[span].m_begin;
+    }
+
+    return c_noParticle;
+  }
+
+  /*!***********************************************************************************
+  \brief  index of a particle in the storage from the index of its gpu data
+  *************************************************************************************/
+  unsigned GetStorageIndex(unsigned pGPUIndex, const particleSpan* pSpans, unsigned pSpanCount)
+  {
+    for (unsigned span = 0; span < pSpanCount; ++span)
+    {
+      unsigned length = pSpans[span].m_end - pSpans[span].m_begin;
+      if (pGPUIndex < length)
+        return pSpans[span].m_begin + pGPUIndex;
+
+      pGPUIndex -= length;
+    }
+
+    return c_noParticle;
+  }
+}
+
+particleDepthSort::particleDepthSort(particleArena* pArena) : m_minZ(0.0f), m_depthScale(0.0f), m_isValid(false),
+  m_keys(keyVector::allocator_type(pArena ? pArena : &particleArena::GetGlobalArena())), m_scratchKeys(m_keys.get_allocator()),
+  m_order(indexVector::allocator_type(m_keys.get_allocator())), m_storageOrder(m_order.get_allocator()), m_storageRemap(m_order.get_allocator())
+{
+}
+
+void particleDepthSort::Sort(const particleStorage& pStorage, const particleSpan* pSpans, unsigned pSpanCount)
+{
+  unsigned count = ComputeDepthRange(pStorage, pSpans, pSpanCount);
+
+  m_keys.resize(count);
+  m_scratchKeys.resize(count);
+
+  unsigned gpuIndex = 0;
+  for (unsigned span = 0; span < pSpanCount; ++span)
+  {
+    for (unsigned i = pSpans[span].m_begin; i < pSpans[span].m_end; ++i, ++gpuIndex)
+      m_keys[gpuIndex] = MakeKey(pStorage.m_positionZ[i], gpuIndex);
+  }
+
+    // the depth is only 16 bits, so two passes of a counting sort on a byte each sort
+    // it. the keys start out in gpu data order and every pass is stable, so particles
+    // with the same depth stay in that order
+  for (unsigned shift = 32; shift < 48; shift += 8)
+  {
+    unsigned starts[257] = {};
+    for (unsigned i = 0; i < count; ++i)
+      ++starts[((m_keys[i] >> shift) & 0xFF) + 1];
+
+    for (unsigned digit = 0; digit < 256; ++digit)
+      starts[digit + 1] += starts[digit];
+
+    for (unsigned i = 0; i < count; ++i)
+      m_scratchKeys[starts[(m_keys[i] >> shift) & 0xFF]++] = m_keys[i];
+
+    m_keys.swap(m_scratchKeys);
+  }
+
+  StoreOrder(pSpans, pSpanCount);
+}
+
+void particleDepthSort::SortIncremental(const particleStorage& pStorage, const particleSpan* pSpans, unsigned pSpanCount,
+                                        const particleMove* pMoves, unsigned pMoveCount, unsigned pNewCount)
+{
+  if (!m_isValid)
+  {
+    Sort(pStorage, pSpans, pSpanCount);
+    return;
+  }
+
+  unsigned count = ComputeDepthRange(pStorage, pSpans, pSpanCount);
+  unsigned oldCount = count - pNewCount;
+
+    // the compaction moved particles into the slots of dead ones
+  if (pMoveCount)
+  {
+    if (m_storageRemap.size() != pStorage.size())
+    {
+      m_storageRemap.resize(pStorage.size());
+      std::iota(m_storageRemap.begin(), m_storageRemap.end(), 0u);
+    }
+
+    for (unsigned move = 0; move < pMoveCount; ++move)
+      m_storageRemap[pMoves[move].m_to] = c_noParticle;
+    for (unsigned move = 0; move < pMoveCount; ++move)
+      m_storageRemap[pMoves[move].m_from] = pMoves[move].m_to;
+
+    for (unsigned& storageIndex : m_storageOrder)
+      storageIndex = m_storageRemap[storageIndex];
+
+    for (unsigned move = 0; move < pMoveCount; ++move)
+    {
+      m_storageRemap[pMoves[move].m_to] = pMoves[move].m_to;
+      m_storageRemap[pMoves[move].m_from] = pMoves[move].m_from;
+    }
+  }
+
+    // following the particles of the last order to where they are now. particles that
+    // aren't active anymore, or whose slot was taken by a new particle, are dropped
+  m_keys.resize(m_storageOrder.size() + pNewCount);
+
+  unsigned keptCount = 0;
+  for (unsigned storageIndex : m_storageOrder)
+  {
+    unsigned gpuIndex = (storageIndex != c_noParticle) ? GetGPUIndex(storageIndex, pSpans, pSpanCount) : c_noParticle;
+    if (gpuIndex < oldCount)
+      m_keys[keptCount++] = MakeKey(pStorage.m_positionZ[storageIndex], gpuIndex);
+  }
+
+    // particles were added or moved some other way, the last order is no good
+  if (keptCount != oldCount)
+  {
+    Sort(pStorage, pSpans, pSpanCount);
+    return;
+  }
+
+    // insertion sort is O(n) when the order is nearly right, if it isn't the radix sort
+    // is quicker. the compaction changes where particles are in the gpu data, so
+    // particles at the same depth are left in last update's order rather than sorted
+    // by it
+  unsigned shiftBudget = oldCount * c_maxShiftsPerParticle;
+  for (unsigned i = 1; i < oldCount; ++i)
+  {
+    std::uint64_t key = m_keys[i];
+    unsigned j = i;
+
+    for (; j && IsBehind(key, m_keys[j - 1]); --j)
+      m_keys[j] = m_keys[j - 1];
+    m_keys[j] = key;
+
+    unsigned shiftCount = i - j;
+    if (shiftCount > shiftBudget)
+    {
+      Sort(pStorage, pSpans, pSpanCount);
+      return;
+    }
+
+    shiftBudget -= shiftCount;
+  }
+
+    // new particles can be at any depth, so they're sorted on their own (they're the
+    // last ones in the gpu data) and merged in
+  m_keys.resize(count);
+  for (unsigned gpuIndex = oldCount; gpuIndex < count; ++gpuIndex)
+    m_keys[gpuIndex] = MakeKey(pStorage.m_positionZ[GetStorageIndex(gpuIndex, pSpans, pSpanCount)], gpuIndex);
+
+  std::sort(m_keys.begin() + oldCount, m_keys.end());
+
+  m_scratchKeys.resize(count);
+  std::merge(m_keys.begin(), m_keys.begin() + oldCount, m_keys.begin() + oldCount, m_keys.end(), m_scratchKeys.begin(), IsBehind);
+  m_keys.swap(m_scratchKeys);
+
+  StoreOrder(pSpans, pSpanCount);
+}
+
+void particleDepthSort::Invalidate()
+{
+  m_isValid = false;
+}
+
+const unsigned* particleDepthSort::GetOrder() const
+{
+  return m_order.data();
+}
+
+unsigned particleDepthSort::size() const
+{
+  return static_cast<unsigned>(m_order.size());
+}
+
+unsigned particleDepthSort::ComputeDepthRange(const particleStorage& pStorage, const particleSpan* pSpans, unsigned pSpanCount)
+{
+  unsigned count = 0;
+  float minZ = 0.0f;
+  float maxZ = 0.0f;
+
+  for (unsigned span = 0; span < pSpanCount; ++span)
+  {
+    for (unsigned i = pSpans[span].m_begin; i < pSpans[span].m_end; ++i, ++count)
+    {
+      float z = pStorage.m_positionZ[i];
+      minZ = (!count || (z < minZ)) ? z : minZ;
+      maxZ = (!count || (z > maxZ)) ? z : maxZ;
+    }
+  }
+
+  m_minZ = minZ;
+  m_depthScale = (maxZ > minZ) ? 65535.0f / (maxZ - minZ) : 0.0f;
+  return count;
+}
+
+std::uint64_t particleDepthSort::MakeKey(float pZ, unsigned pGPUIndex) const
+{
+  float depth = (pZ - m_minZ) * m_depthScale;
+  depth = (depth > 0.0f) ? depth : 0.0f;
+  depth = (depth < 65535.0f) ? depth : 65535.0f;
+
+  return (static_cast<std::uint64_t>(depth) << 32) | pGPUIndex;
+}
+
+void particleDepthSort::StoreOrder(const particleSpan* pSpans, unsigned pSpanCount)
+{
+  m_order.resize(m_keys.size());
+  m_storageOrder.resize(m_keys.size());
+
+  for (unsigned i = 0; i < m_keys.size(); ++i)
+  {
+    m_order[i] = static_cast<unsigned>(m_keys[i]);
+    m_storageOrder[i] = GetStorageIndex(m_order[i], pSpans, pSpanCount);
+  }
+
+  m_isValid = true;
+}
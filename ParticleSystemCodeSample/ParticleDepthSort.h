@@ -0,0 +1,135 @@
+/*!****************************************************************************************
+\file       ParticleDepthSort.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particleDepthSort class. Works out the order the active
+particles of an emitter have to be drawn in for alpha blending (back to front).
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "ParticleArena.h"
+
+// forward declarations
+struct particleStorage;
+struct particleSpan;
+struct particleMove;
+
+/*!*************************************************************************************
+\par class: particleDepthSort
+
+\brief  Sorts the active particles by z, smallest (furthest from a camera looking down
+        -z) first. Only the order is worked out, as indices into the gpu data (where the
+        active particles are in [0, live count)), so the particles themselves are never
+        moved for it.
+
+        A full sort is a radix sort of the depth quantized to 16 bits (two passes of a
+        counting sort). The incremental sort starts from last frame's order instead,
+        follows the particles that were moved by the compaction, drops the dead ones
+        and fixes it up with an insertion sort. Particles barely change depth from one
+        frame to the next, so that's close to O(n). The new particles are sorted on
+        their own and merged in. If the order changed too much it falls back to the full
+        sort.
+\par baseClass: true
+***************************************************************************************/
+class particleDepthSort
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for the sort
+
+  \param pArena - arena the sort allocates from (nullptr for the global arena)
+  *************************************************************************************/
+  explicit particleDepthSort(particleArena* pArena = nullptr);
+
+  /*!***********************************************************************************
+  \brief  Sorts the active particles from scratch
+
+  \param pStorage - storage holding the particles
+  \param pSpans - ranges of active particles, in the order their gpu data is written
+  \param pSpanCount - number of ranges
+  *************************************************************************************/
+  void Sort(const particleStorage& pStorage, const particleSpan* pSpans, unsigned pSpanCount);
+
+  /*!***********************************************************************************
+  \brief  Sorts the active particles starting from the last order (falls back to Sort if
+          there's none or it's too far off)
+
+  \param pStorage - storage holding the particles
+  \param pSpans - ranges of active particles, in the order their gpu data is written
+  \param pSpanCount - number of ranges
+  \param pMoves - moves made to the particles since the last sort (by the compaction)
+  \param pMoveCount - number of moves
+  \param pNewCount - number of particles spawned since the last sort (the last ones in
+         the ranges)
+  *************************************************************************************/
+  void SortIncremental(const particleStorage& pStorage, const particleSpan* pSpans, unsigned pSpanCount,
+                       const particleMove* pMoves, unsigned pMoveCount, unsigned pNewCount);
+
+  /*!***********************************************************************************
+  \brief  Forgets the last order (needed when the particles were moved without the
+          moves being passed in, like when the storage is rotated or resized)
+  *************************************************************************************/
+  void Invalidate();
+
+  /*!***********************************************************************************
+  \brief  Gets the order to draw the particles in
+
+  \return index into the gpu data of every particle, back to front
+  *************************************************************************************/
+  const unsigned* GetOrder() const;
+
+  /*!***********************************************************************************
+  \brief  Gets the number of particles in the order
+
+  \return number of particles sorted
+  *************************************************************************************/
+  unsigned size() const;
+
+private:
+  typedef std::vector<unsigned, particleArenaAllocator<unsigned> > indexVector;
+  typedef std::vector<std::uint64_t, particleArenaAllocator<std::uint64_t> > keyVector;
+
+  /*!***********************************************************************************
+  \brief  Finds the range of z the active particles are in, so the depth can be
+          quantized over it
+
+  \param pStorage - storage holding the particles
+  \param pSpans - ranges of active particles
+  \param pSpanCount - number of ranges
+  \return number of active particles
+  *************************************************************************************/
+  unsigned ComputeDepthRange(const particleStorage& pStorage, const particleSpan* pSpans, unsigned pSpanCount);
+
+  /*!***********************************************************************************
+  \brief  Gets the sort key of a particle (quantized depth in the high 32 bits and its
+          gpu data index in the low 32 bits, so sorting the keys sorts the indices)
+
+  \param pZ - z of the particle
+  \param pGPUIndex - index of the particle's gpu data
+  \return sort key
+  *************************************************************************************/
+  std::uint64_t MakeKey(float pZ, unsigned pGPUIndex) const;
+
+  /*!***********************************************************************************
+  \brief  Copies the sorted keys into the order, along with where every particle is in
+          the storage (for the next incremental sort)
+
+  \param pSpans - ranges of active particles
+  \param pSpanCount - number of ranges
+  *************************************************************************************/
+  void StoreOrder(const particleSpan* pSpans, unsigned pSpanCount);
+
+  float m_minZ;       //!< smallest z of the active particles
+  float m_depthScale; //!< turns z - m_minZ into [0, 65535]
+  bool m_isValid;     //!< if the last order can be used by the incremental sort
+
+  keyVector m_keys;               //!< sort keys of the active particles
+  keyVector m_scratchKeys;        //!< second buffer for the radix sort
+  indexVector m_order;            //!< gpu data index of every particle, back to front
+  indexVector m_storageOrder;     //!< storage index of every particle, back to front
+  indexVector m_storageRemap;     //!< where a particle of the storage was moved to (itself if it wasn't)
+};
@@ -0,0 +1,178 @@
+/*!****************************************************************************************
+\file       ParticleDistanceField.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particleDistanceField class.
+******************************************************************************************/
+
+#include "ParticleDistanceField.h"
+#include <cmath>
+#include "../Transform.h"
+#include "../Physics/ColliderPolygon.h"
+
+particleDistanceField::particleDistanceField() : m_width(0), m_height(0), m_originX(0.0f), m_originY(0.0f), m_cellSize(1.0f),
+  m_outsideDistance(1.0f)
+{
+}
+
+void particleDistanceField::Bake(const vector4* pVertices, unsigned pVertexCount, float pCellSize, float pMargin)
+{
+  m_distances.clear();
+  m_width = m_height = 0;
+  if (!pVertexCount || (pCellSize <= 0.0f))
+    return;
+
+  float minX = pVertices[0].x, minY = pVertices[0].y;
+  float maxX = pVertices[0].x, maxY = pVertices[0].y;
+  for (unsigned i = 1; i < pVertexCount; ++i)
+  {
+    minX = (pVertices[i].x < minX) ? pVertices[i].x : minX;
+    minY = (pVertices[i].y < minY) ? pVertices[i].y : minY;
+    maxX = (pVertices[i].x > maxX) ? pVertices[i].x : maxX;
+    maxY = (pVertices[i].y > maxY) ? pVertices[i].y : maxY;
+  }
+
+  m_cellSize = pCellSize;
+  m_outsideDistance = pMargin;
+  m_originX = minX - pMargin;
+  m_originY = minY - pMargin;
+  m_width = static_cast<unsigned>(std::ceil((maxX - minX + pMargin * 2.0f) / pCellSize)) + 1;
+  m_height = static_cast<unsigned>(std::ceil((maxY - minY + pMargin * 2.0f) / pCellSize)) + 1;
+  m_distances.resize(m_width * m_height);
+
+  for (unsigned row = 0; row < m_height; ++row)
+  {
+    for (unsigned column = 0; column < m_width; ++column)
+    {
+      float x = m_originX + column * pCellSize;
+      float y = m_originY + row * pCellSize;
+
+      float closestSquared = -1.0f;
+      bool isInside = false;
+
+      for (unsigned i = 0, j = pVertexCount - 1; i < pVertexCount; j = i++)
+      {
+        const vector4& start = pVertices[j];
+        const vector4& end = pVertices[i];
+
+          // distance to the face
+        float faceX = end.x - start.x;
+        float faceY = end.y - start.y;
+        float faceLengthSquared = faceX * faceX + faceY * faceY;
+        float t = faceLengthSquared ? ((x - start.x) * faceX + (y - start.y) * faceY) / faceLengthSquared : 0.0f;
+        t = (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+
+        float offsetX = x - (start.x + faceX * t);
+        float offsetY = y - (start.y + faceY * t);
+        float distanceSquared = offsetX * offsetX + offsetY * offsetY;
+        if ((closestSquared < 0.0f) || (distanceSquared < closestSquared))
+          closestSquared = distanceSquared;
+
+          // crossing test, an odd number of faces to the right means inside
+        if (((start.y > y) != (end.y > y)) && (x < start.x + (y - start.y) * faceX / faceY))
+          isInside = !isInside;
+      }
+
+      float distance = std::sqrt(closestSquared);
+      m_distances[row * m_width + column] = isInside ? -distance : distance;
+    }
+  }
+}
+
+void particleDistanceField::Bake(const transform& pTransform, colliderPolygon& pCollider, float pCellSize, float pMargin)
+{
+  const std::vector<vector4>& vertices = static_cast<polygon&>(pCollider.GetColliderShape()).GetVertexList();
+
+  std::vector<vector4> worldVertices(vertices.size());
+  for (unsigned i = 0; i < vertices.size(); ++i)
+    worldVertices[i] = pTransform.GetLinearTransformation() * vertices[i] + pTransform.pos();
+
+  Bake(worldVertices.data(), static_cast<unsigned>(worldVertices.size()), pCellSize, pMargin);
+}
+
+float particleDistanceField::GetDistance(float pX, float pY) const
+{
+  unsigned cell;
+  float fractionX, fractionY;
+  if (!FindCell(pX, pY, cell, fractionX, fractionY))
+    return m_outsideDistance;
+
+  float bottom = m_distances[cell] + (m_distances[cell + 1] - m_distances[cell]) * fractionX;
+  float top = m_distances[cell + m_width] + (m_distances[cell + m_width + 1] - m_distances[cell + m_width]) * fractionX;
+  return bottom + (top - bottom) * fractionY;
+}
+
+float particleDistanceField::GetDistance(float pX, float pY, float& pNormalX, float& pNormalY) const
+{
+  unsigned cell;
+  float fractionX, fractionY;
+  if (!FindCell(pX, pY, cell, fractionX, fractionY))
+  {
+    pNormalX = pNormalY = 0.0f;
+    return m_outsideDistance;
+  }
+
+  float bottomLeft = m_distances[cell];
+  float bottomRight = m_distances[cell + 1];
+  float topLeft = m_distances[cell + m_width];
+  float topRight = m_distances[cell + m_width + 1];
+
+    // gradient of the bilinear interpolation
+  float gradientX = (bottomRight - bottomLeft) * (1.0f - fractionY) + (topRight - topLeft) * fractionY;
+  float gradientY = (topLeft - bottomLeft) * (1.0f - fractionX) + (topRight - bottomRight) * fractionX;
+  float gradientLength = std::sqrt(gradientX * gradientX + gradientY * gradientY);
+
+  pNormalX = gradientLength ? gradientX / gradientLength : 0.0f;
+  pNormalY = gradientLength ? gradientY / gradientLength : 0.0f;
+
+  float bottom = bottomLeft + (bottomRight - bottomLeft) * fractionX;
+  float top = topLeft + (topRight - topLeft) * fractionX;
+  return bottom + (top - bottom) * fractionY;
+}
+
+unsigned particleDistanceField::FindInside(const float* pX, const float* pY, unsigned pBegin, unsigned pEnd, unsigned* pInside) const
+{
+  unsigned insideCount = 0;
+
+    // every index is written, but only the ones inside are kept
+  for (unsigned i = pBegin; i < pEnd; ++i)
+  {
+    pInside[insideCount] = i;
+    insideCount += (GetDistance(pX[i], pY[i]) <= 0.0f) ? 1 : 0;
+  }
+
+  return insideCount;
+}
+
+void particleDistanceField::GetBounds(float pBounds[4]) const
+{
+  pBounds[0] = m_originX;
+  pBounds[1] = m_originY;
+  pBounds[2] = m_originX + (m_width ? m_width - 1 : 0) * m_cellSize;
+  pBounds[3] = m_originY + (m_height ? m_height - 1 : 0) * m_cellSize;
+}
+
+bool particleDistanceField::FindCell(float pX, float pY, unsigned& pCell, float& pFractionX, float& pFractionY) const
+{
+  if ((m_width < 2) || (m_height < 2))
+    return false;
+
+  float column = (pX - m_originX) / m_cellSize;
+  float row = (pY - m_originY) / m_cellSize;
+  if (!(column >= 0.0f) || !(row >= 0.0f) || (column > m_width - 1) || (row > m_height - 1))
+    return false;
+
+    // the last sample of a row or column belongs to the cell before it
+  unsigned cellColumn = static_cast<unsigned>(column);
+  unsigned cellRow = static_cast<unsigned>(row);
+  cellColumn = (cellColumn < m_width - 1) ? cellColumn : m_width - 2;
+  cellRow = (cellRow < m_height - 1) ? cellRow : m_height - 2;
+
+  pCell = cellRow * m_width + cellColumn;
+  pFractionX = column - cellColumn;
+  pFractionY = row - cellRow;
+  return true;
+}
@@ -0,0 +1,123 @@
+/*!****************************************************************************************
+\file       ParticleDistanceField.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particleDistanceField class. Static colliders are baked
+into one when the level loads, so particles can collide with them at the same cost no
+matter how many faces they have.
+******************************************************************************************/
+#pragma once
+#include <vector>
+#include "ParticleArena.h"
+#include "../../../Math/Vector4.h"
+
+// forward declarations
+class transform;
+class colliderPolygon;
+
+/*!*************************************************************************************
+\par class: particleDistanceField
+
+\brief  2D grid of signed distances to a static polygon (negative inside). Looking up
+        a point is a bilinear interpolation of the 4 closest samples and the normal is
+        the gradient of that interpolation, so it's O(1) per particle. Only read after
+        it's baked, so any number of emitters can share it.
+\par baseClass: true
+***************************************************************************************/
+class particleDistanceField
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for an empty field (nothing collides with it until it's baked)
+  *************************************************************************************/
+  particleDistanceField();
+
+  /*!***********************************************************************************
+  \brief  Bakes a polygon given in world space. The field covers the polygon's bounding
+          box plus a border of pMargin.
+
+  \param pVertices - vertices of the polygon in world space (counter clockwise or
+         clockwise, doesn't need to be convex)
+  \param pVertexCount - number of vertices
+  \param pCellSize - distance between two samples (smaller is more exact)
+  \param pMargin - how far outside of the polygon the field reaches
+  *************************************************************************************/
+  void Bake(const vector4* pVertices, unsigned pVertexCount, float pCellSize, float pMargin = 1.0f);
+
+  /*!***********************************************************************************
+  \brief  Bakes a polygon collider where it currently is (for colliders that never move)
+
+  \param pTransform - transform of the collider
+  \param pCollider - collider to bake
+  \param pCellSize - distance between two samples (smaller is more exact)
+  \param pMargin - how far outside of the polygon the field reaches
+  *************************************************************************************/
+  void Bake(const transform& pTransform, colliderPolygon& pCollider, float pCellSize, float pMargin = 1.0f);
+
+  /*!***********************************************************************************
+  \brief  Gets the distance from a point to the polygon
+
+  \param pX - x of the point
+  \param pY - y of the point
+  \return signed distance (negative inside, pMargin or more outside of the field)
+  *************************************************************************************/
+  float GetDistance(float pX, float pY) const;
+
+  /*!***********************************************************************************
+  \brief  Gets the distance from a point to the polygon and the direction away from it
+
+  \param pX - x of the point
+  \param pY - y of the point
+  \param pNormalX - filled with x of the normalized gradient (pointing out of the polygon)
+  \param pNormalY - filled with y of the normalized gradient (pointing out of the polygon)
+  \return signed distance (negative inside, pMargin or more outside of the field)
+  *************************************************************************************/
+  float GetDistance(float pX, float pY, float& pNormalX, float& pNormalY) const;
+
+  /*!***********************************************************************************
+  \brief  Finds the points in a range that are inside the polygon (a distance of 0 or
+          less), with a single lookup each and no gradient
+
+  \param pX - x of every point
+  \param pY - y of every point
+  \param pBegin - first point to check
+  \param pEnd - one past the last point to check
+  \param pInside - filled with the indices of the points inside (needs room for
+         pEnd - pBegin indices)
+  \return number of points inside
+  *************************************************************************************/
+  unsigned FindInside(const float* pX, const float* pY, unsigned pBegin, unsigned pEnd, unsigned* pInside) const;
+
+  /*!***********************************************************************************
+  \brief  Gets the area covered by the field
+
+  \param pBounds - filled with min x, min y, max x and max y
+  *************************************************************************************/
+  void GetBounds(float pBounds[4]) const;
+
+private:
+  /*!***********************************************************************************
+  \brief  Finds the cell a point is in
+
+  \param pX - x of the point
+  \param pY - y of the point
+  \param pCell - filled with the index of the cell's bottom left sample
+  \param pFractionX - filled with how far along the cell the point is in x [0, 1]
+  \param pFractionY - filled with how far along the cell the point is in y [0, 1]
+  \return false if the point is outside of the field
+  *************************************************************************************/
+  bool FindCell(float pX, float pY, unsigned& pCell, float& pFractionX, float& pFractionY) const;
+
+  typedef std::vector<float, particleArenaAllocator<float> > floatVector;
+
+  floatVector m_distances; //!< signed distance of every sample, row by row
+  unsigned m_width;        //!< number of samples in a row
+  unsigned m_height;       //!< number of rows
+  float m_originX;         //!< x of the first sample
+  float m_originY;         //!< y of the first sample
+  float m_cellSize;        //!< distance between two samples
+  float m_outsideDistance; //!< distance given for points outside of the field
+};
@@ -10,8 +10,16 @@ handles the particle emitter's movement as a whole.
 ******************************************************************************************/
 
 #include "ParticleEmitter.h"
+#include "ParticleEmitterCommon.h"
 #include "Particle.h"
+#include "ParticleKernels.h"
+#include "ParticleJobSystem.h"
+#include "ParticleEmitterScheduler.h"
+#include "ParticleGPURing.h"
+#include <atomic>
+#include <climits>
 #include <numeric>
+#include <utility>
 #include "../../../Tools/ScalarTools.h"
 #include "../Physics/Collider.h"
 #include "../../Systems/SystemManager.h"
@@ -24,255 +32,426 @@ handles the particle emitter's movement as a whole.
 #include "../Physics/RigidBody.h"
 
 
-particleEmitter::particleEmitter(const emitterData& pEmitterData) : m_emitterData(pEmitterData), m_liveParticleCount(0), m_currentLifeTime(0.0f), m_isEmitterActive(true), m_currentWaveTime(0)
+particleEmitter::particleEmitter(const emitterData& pEmitterData, particleArena* pArena) : m_emitterData(pEmitterData), m_liveParticleCount(0), m_currentLifeTime(0.0f), m_isEmitterActive(true), m_currentWaveTime(0), m_jobSystem(nullptr), m_scheduler(nullptr), m_parent(nullptr), m_gpuRing(nullptr),
+  m_lodSpawnRateScale(1.0f), m_lodParticleCapScale(1.0f), m_lodUpdateInterval(1), m_lodCollides(true), m_lodSkippedFrames(0), m_lodSkippedTime(0.0f), m_stepAccumulator(0.0f),
+  m_isRingBuffer(false), m_ringStart(0), m_isAnalytic(pEmitterData.m_useAnalyticMotion && !pEmitterData.m_isInteractable && !pEmitterData.m_interactsWithSelf),
+    // every particle the emitter can hold is allocated up front, so nothing is allocated while it runs
+  m_particles(pEmitterData.m_numberofParticles, pArena), m_selfInteractionGrid(pArena),
+  m_colliderVertices(vertexVector::allocator_type(m_particles.GetArena())), m_colliderPlanes(floatVector::allocator_type(m_particles.GetArena())),
+  m_polygonColliders(polygonColliderVector::allocator_type(m_particles.GetArena())), m_circleColliders(circleColliderVector::allocator_type(m_particles.GetArena())),
+  m_fieldColliders(fieldColliderVector::allocator_type(m_particles.GetArena())),
+  m_gpuDataFormat(gdf_full), m_packedGPUData(particlePackedDataVector::allocator_type(m_particles.GetArena())),
+  m_depthSortMode(dsm_none), m_depthSort(m_particles.GetArena()),
+  m_particleDataForGPUs(pEmitterData.m_numberofParticles, particleGPUDataVector::allocator_type(pArena ? pArena : &particleArena::GetGlobalArena()))
+#ifdef PARTICLE_PROFILING
+  , m_profile(pEmitterData.m_emitterName)
+#endif
 {
   m_timeBetweenParticles = 1.0f / (float)m_emitterData.m_particlesPerSecond;
   m_timesSinceLastParticleSpawned = 0.0f;
 
+    // only the stages of the update the emitter needs are compiled into its kernel
+  m_updateFeatures = GetUpdateFeatures(m_emitterData);
+  m_updateKernel = ParticleKernels::GetUpdateKernel(m_updateFeatures);
+
+    // the same seed spawns the same particles every run
+  if (m_emitterData.m_randomSeed)
+    m_random.Seed(m_emitterData.m_randomSeed);
+  else
+    m_random.Seed(particleRandom::GetUniqueSeed());
+
+    // particles die in the order they're born if they all live as long, so they can just
+    // be pushed on one end of a ring buffer and taken off the other
+  if (!m_emitterData.m_randomParticleLifetimeRange)
+    m_isRingBuffer = true;
+
   if (pEmitterData.m_startOnTrigger)
     m_isEmitterActive = false;
 }
 
 void particleEmitter::UpdateParticleEmitter(float dt, transform& pTransform)
 {
+    // nothing can change until the emitter is restarted
+  if (IsDormant())
+  {
+    m_additionalForce.Clear();
+    return;
+  }
+
+    // far away emitters skip frames and make up for them in one step. the forces added
+    // over those frames are averaged, since they're applied over all of their time
+  m_lodSkippedTime += dt;
+  if (++m_lodSkippedFrames < m_lodUpdateInterval)
+    return;
+
+  dt = m_lodSkippedTime;
+  m_lodSkippedTime = 0.0f;
+
+    // the frame's stats are handed over to the profiler once the update is done
+  PARTICLE_PROFILE_FRAME(m_profile, m_parent);
+
+    // with a fixed time step the time is used up in whole steps and the rest is carried
+    // over. frames that don't make a whole step only move the rendered particles along,
+    // their forces are averaged into the next step like the ones of skipped frames
+  bool isFixedStep = m_emitterData.m_fixedTimeStep > 0.0f;
+  unsigned stepCount = isFixedStep ? TakeFixedSteps(dt) : 1;
+  float stepTime = isFixedStep ? m_emitterData.m_fixedTimeStep : dt;
+
+  m_gpuDataOrigin = pTransform.pos() + m_emitterData.m_offset;
+  if (!stepCount)
+  {
+    WriteGPUData();
+    return;
+  }
+
+  m_additionalForce *= 1.0f / m_lodSkippedFrames;
+  m_lodSkippedFrames = 0;
+
     // additional forces are added during a frame
   vector4 totalForce = m_additionalForce + m_emitterData.m_constantAcceleration;
-  m_timesSinceLastParticleSpawned += dt;
 
-  if (m_particles.size() < m_emitterData.m_numberofParticles)
+    // particles with random lifetimes don't die in order anymore
+  if (m_isRingBuffer && m_emitterData.m_randomParticleLifetimeRange)
+    StopRingBuffer();
+
+    // particles that collide can't be evaluated in closed form
+  if (m_isAnalytic != CanBeAnalytic())
   {
-      // create particle if not enough (default set to inactive)
-    CreateParticle(pTransform.pos());
+    if (m_isAnalytic)
+      StopAnalyticMode();
+    else
+      StartAnalyticMode();
   }
 
-    // updating each particle
-  for (auto& currentParticle : m_particles)
+    // the pool only changes size if the client changed the number of particles
+  if (m_particles.size() != m_emitterData.m_numberofParticles)
+    ResizeParticlePool(m_emitterData.m_numberofParticles);
+
+    // same for the update kernel, it only changes if the client changed the emitter data
+  unsigned updateFeatures = GetUpdateFeatures(m_emitterData);
+  if (updateFeatures != m_updateFeatures)
   {
-    UpdateParticle(totalForce, currentParticle, dt, pTransform);
+    m_updateFeatures = updateFeatures;
+    m_updateKernel = ParticleKernels::GetUpdateKernel(m_updateFeatures);
   }
-  m_currentLifeTime += dt; // increment the lifetime of the entire particle emitter
 
-  if (m_currentLifeTime > m_emitterData.m_totalLifeTime)
+  for (unsigned step = 0; step < stepCount; ++step)
   {
-      // time to kill a particle emitter
-    m_currentLifeTime = 0;
+      // the colliders checked before the update are checked again after every step, so
+      // particles can't pass through them in between (the last step is checked with the
+      // next frame's colliders)
+    if (step)
+      ResolvePreparedCollisions();
 
-      // if total lifetime is 0, it means that it is immortal
-    if (m_emitterData.m_totalLifeTime)
-      m_isEmitterActive = false;
+    StepParticles(totalForce, stepTime, pTransform);
+  }
+
+    // the colliders are only good for the frame they were checked in
+  if (isFixedStep)
+  {
+    m_polygonColliders.clear();
+    m_circleColliders.clear();
+    m_fieldColliders.clear();
   }
 
-  UpdateParticleEmitterWaveTiming(dt);
+    // handing the updated particles over to the renderer
+  WriteGPUData();
+
+  float simulatedTime = stepTime * stepCount;
+  ParticleEmitterCommon::UpdateEmitterLifetime(m_emitterData, simulatedTime, m_currentLifeTime, m_isEmitterActive);
+  UpdateParticleEmitterWaveTiming(simulatedTime);
 
     // clears the forces accumulated over the last frame.
   m_additionalForce.Clear();
 }
 
-void particleEmitter::UpdateParticleEmitterWaveTiming(float dt)
+void particleEmitter::StepParticles(const vector4& pTotalForce, float dt, transform& pTransform)
 {
-	// nothing to update if emitter is inactive
-  if (!m_isEmitterActive)
-    return;
-
-  // updating the particle emitter activity according to the waves data
-  m_currentWaveTime += dt;
-
-    // if particle emitter is currently unpaused, update it with the wave on time
-  if (!m_isEmitterPaused)
+  m_timesSinceLastParticleSpawned += dt * m_lodSpawnRateScale;
+
+    // active particles are contiguous in the storage, so they are updated in batches.
+    // particles that die are only marked, they're removed all at once afterwards
+  std::atomic<unsigned> deathCount(0);
+  particleSpan liveSpans[2];
+  unsigned liveSpanCount = GetLiveSpans(liveSpans);
+
+    // analytic particles keep the state they spawned with, so the additional forces are
+    // folded into it: the velocity changes from now on and the position is shifted back
+    // so it doesn't jump
+  if (m_isAnalytic && (m_additionalForce.x || m_additionalForce.y))
   {
-    if (m_currentWaveTime >= m_emitterData.m_waveOnTime)
-    {
-        // wave duration is complete, pausing the emitter
-      m_isEmitterPaused = true;
-      m_currentWaveTime = 0;
-    }
-  }
-  else // else update it with the wave off time
-  {
-    if (m_currentWaveTime >= m_emitterData.m_waveOffTime)
+    float velocityChangeX = m_additionalForce.x * (dt / 2.0f);
+    float velocityChangeY = m_additionalForce.y * (dt / 2.0f);
+
+    for (unsigned span = 0; span < liveSpanCount; ++span)
     {
-        // pause in between waves are complete, unpausing the emitter
-      m_isEmitterPaused = false;
-      m_currentWaveTime = 0;
+      for (unsigned i = liveSpans[span].m_begin; i < liveSpans[span].m_end; ++i)
+      {
+        m_particles.m_velocityX[i] += velocityChangeX;
+        m_particles.m_velocityY[i] += velocityChangeY;
+        m_particles.m_positionX[i] -= velocityChangeX * m_particles.m_currentLifetime[i];
+        m_particles.m_positionY[i] -= velocityChangeY * m_particles.m_currentLifetime[i];
+      }
     }
   }
-}
 
-void particleEmitter::UpdateParticle(const vector4& accumulatedForce, particle& particle, float dt, transform& pTransform)
-{
-    // update activity
-  UpdateParticleActivity(particle, dt, pTransform);
+    // overlaps are moved apart right away, the bounces are picked up by the physics update
+  if (m_emitterData.m_interactsWithSelf)
+    ResolveSelfInteractions();
 
-    // update particle data if its active
-  if (particle.IsActive())
+  for (unsigned i = 0; i < liveSpanCount; ++i)
   {
-      // update particle colors
-    UpdateParticleColors(particle);
+    ParticleEmitterCommon::RunInChunks(m_jobSystem, liveSpans[i].m_begin, liveSpans[i].m_end, [this, &pTotalForce, &deathCount, dt](unsigned pBegin, unsigned pEnd)
+    {
+        // everything but the lifetime of an analytic particle is worked out when the gpu
+        // data is written
+      if (m_isAnalytic)
+      {
+        PARTICLE_PROFILE_PHASE(m_profile, pp_integrate);
+        ParticleKernels::UpdateLifetimes(m_particles, pBegin, pEnd, dt);
+      }
+      else
+        UpdateParticleRange(pTotalForce, pBegin, pEnd, dt);
 
-      // update particle scale
-    UpdateParticleScale(particle);
+        // a ring buffer only has to check its oldest particles
+      if (!m_isRingBuffer)
+        deathCount += ParticleKernels::MarkDeadParticles(m_particles, pBegin, pEnd);
+    });
+  }
 
-      // update physics
-    UpdateParticlePhysics(accumulatedForce, particle, dt);
+    // killing and spawning particles moves them around, so it can only happen after the
+    // batches are done
+  if (m_isRingBuffer)
+    KillOldestParticles();
+  else if (deathCount)
+  {
+    m_liveParticleCount = ParticleKernels::CompactParticles(m_particles, m_liveParticleCount);
+    PARTICLE_PROFILE_COUNT(m_profile, pc_deaths, deathCount);
+    PARTICLE_PROFILE_COUNT(m_profile, pc_swaps, m_particles.m_moveCount);
   }
+
+  unsigned survivorCount = m_liveParticleCount;
+  SpawnParticles(pTransform);
+  SortParticlesByDepth(!m_isRingBuffer && deathCount, m_liveParticleCount - survivorCount);
 }
 
-  // handles whether a particle should be active or inactive
-void particleEmitter::UpdateParticleActivity(particle& particle, float dt, transform& pTransform)
+unsigned particleEmitter::TakeFixedSteps(float dt)
 {
-    // increment lifetime only if it's active
-  if (particle.IsActive())
-    particle.GetCurrentLifetime() += dt;
+  float step = m_emitterData.m_fixedTimeStep;
+  unsigned maxSteps = m_emitterData.m_maxSubsteps ? m_emitterData.m_maxSubsteps : 1;
 
-  if ((m_timesSinceLastParticleSpawned > m_timeBetweenParticles) && m_isEmitterActive && !m_isEmitterPaused)
-  {
-    if (m_liveParticleCount < m_emitterData.m_numberofParticles)
-    {
-        // only respawn if there are too less particles active atm and if there has been
-        // enough time between the last particle spawning
-      if (!particle.IsActive())
-      {
-          // ressurecting the dead ass particle because there arent enough active
-        ResetParticle(particle, pTransform);
-        particle.SetActive(true);
-        SwapWithFirstInactiveParticle(particle);
-        ++m_liveParticleCount;
-        m_timesSinceLastParticleSpawned -= m_timeBetweenParticles;
-      }
-    }
-  }
+  m_stepAccumulator += dt;
+  unsigned stepCount = static_cast<unsigned>(m_stepAccumulator / step);
 
-    // setting a particle to inactive(aka particle murder) if it's lived a whole full life
-  if (particle.GetCurrentLifetime() > particle.GetTotalLifetime())
+    // more steps would only make a long frame longer, so the time past the cap is dropped
+    // and the particles slow down for a moment instead
+  if (stepCount > maxSteps)
   {
-    particle.GetCurrentLifetime() = 0;
-    particle.SetActive(false);
-    SwapWithLastActiveParticle(particle);
-    --m_liveParticleCount;
+    stepCount = maxSteps;
+    m_stepAccumulator = fmodf(m_stepAccumulator, step);
   }
+  else
+    m_stepAccumulator -= step * stepCount;
+
+  m_stepAccumulator = (m_stepAccumulator > 0.0f) ? m_stepAccumulator : 0.0f;
+  return stepCount;
 }
 
-void particleEmitter::UpdateParticleScale(particle& particle)
+float particleEmitter::GetRenderInterpolation() const
 {
-    // t is 0 when lifetime of particle is 0
-    // t is 1 when life time of particle has maxed
-  float particleCurrLifetime = particle.GetCurrentLifetime();
-  float t = particleCurrLifetime / particle.GetTotalLifetime();
+  if (m_emitterData.m_fixedTimeStep <= 0.0f)
+    return 1.0f;
 
-  vector4 newScale = m_particleDataForGPUs[particle.GetGPUData()].m_particleTransform.Scl();
-  newScale.x = particle.GetRandomScale()[0] + (particle.GetRandomScale()[1] - particle.GetRandomScale()[0]) * t;
-  newScale.y = particle.GetRandomScale()[0] + (particle.GetRandomScale()[1] - particle.GetRandomScale()[0]) * t;
+  float interpolation = m_stepAccumulator / m_emitterData.m_fixedTimeStep;
+  return (interpolation < 1.0f) ? interpolation : 1.0f;
+}
 
-  m_particleDataForGPUs[particle.GetGPUData()].m_particleTransform.Scl(newScale);
+float particleEmitter::GetRenderTimeOffset() const
+{
+    // the interpolated particles are between the last two steps
+  return (m_emitterData.m_fixedTimeStep > 0.0f) ? (GetRenderInterpolation() - 1.0f) * m_emitterData.m_fixedTimeStep : 0.0f;
 }
 
-void particleEmitter::UpdateParticleColors(particle& particle)
+void particleEmitter::UpdateParticleEmitters(std::vector<particleEmitterUpdate>& pEmitters, float dt, particleJobSystem& pJobSystem)
 {
-  // t is 0 when lifetime of particle is 0
-  // t is 1 when life time of particle has maxed
-  float particleCurrLifetime = particle.GetCurrentLifetime();
-  float t = particleCurrLifetime / particle.GetTotalLifetime();
+    // one job per emitter, the job system joins them all before returning
+  pJobSystem.ParallelFor(static_cast<unsigned>(pEmitters.size()), [&pEmitters, dt](unsigned i)
+  {
+    pEmitters[i].m_emitter->UpdateParticleEmitter(dt, *pEmitters[i].m_transform);
+  });
+}
 
-  vector4 newColor = m_particleDataForGPUs[particle.GetGPUData()].m_particleColor;
-  newColor.x = m_emitterData.m_initialColor.x + (m_emitterData.m_finalColor.x - m_emitterData.m_initialColor.x) * t; // red
-  newColor.y = m_emitterData.m_initialColor.y + (m_emitterData.m_finalColor.y - m_emitterData.m_initialColor.y) * t; // green
-  newColor.z = m_emitterData.m_initialColor.z + (m_emitterData.m_finalColor.z - m_emitterData.m_initialColor.z) * t; // blue
-  newColor.w = m_emitterData.m_initialColor.w + (m_emitterData.m_finalColor.w - m_emitterData.m_initialColor.w) * t; // alpha
+void particleEmitter::UpdateParticleRange(const vector4& accumulatedForce, unsigned pBegin, unsigned pEnd, float dt)
+{
+  ParticleKernels::updateParameters parameters = { accumulatedForce, m_emitterData.m_initialColor, m_emitterData.m_finalColor, dt };
 
-  m_particleDataForGPUs[particle.GetGPUData()].m_particleColor = newColor;
+    // the colors and scales are in the same kernel, so they're timed along with the integration
+  PARTICLE_PROFILE_PHASE(m_profile, pp_integrate);
+  m_updateKernel(m_particles, pBegin, pEnd, parameters);
 }
 
-void particleEmitter::ResetParticle(particle& particle, const transform& pTransform)
+unsigned particleEmitter::GetUpdateFeatures(const emitterData& pEmitterData)
 {
-    // setting a random Position
-  float xRandomPosOffset = 0.0f;
-  float yRandomPosOffset = 0.0f;
-  float zRandomPosOffset = 0.0f;
+  const vector4& initialColor = pEmitterData.m_initialColor;
+  const vector4& finalColor = pEmitterData.m_finalColor;
+  unsigned features = 0;
 
-  if (m_emitterData.m_randomPositionRange.x)
-    xRandomPosOffset = ScalarTools::RandomRange(-m_emitterData.m_randomPositionRange.x, m_emitterData.m_randomPositionRange.x);
-  if (m_emitterData.m_randomPositionRange.y)
-    yRandomPosOffset = ScalarTools::RandomRange(-m_emitterData.m_randomPositionRange.y, m_emitterData.m_randomPositionRange.y);
-  if (m_emitterData.m_randomPositionRange.z)
-	  zRandomPosOffset = ScalarTools::RandomRange(-m_emitterData.m_randomPositionRange.z, m_emitterData.m_randomPositionRange.z);
+    // particles spawn with the initial color and scale, so they only change if the final
+    // ones are different
+  if ((initialColor.x != finalColor.x) || (initialColor.y != finalColor.y) || (initialColor.z != finalColor.z) || (initialColor.w != finalColor.w))
+    features |= ParticleKernels::uf_colors;
+  if (pEmitterData.m_randomScaleFactor || (pEmitterData.m_initialScale != pEmitterData.m_finalScale))
+    features |= ParticleKernels::uf_scales;
 
-    // setting position
-  vector4 position = vector4(xRandomPosOffset, yRandomPosOffset, zRandomPosOffset) + pTransform.pos() + m_emitterData.m_offset;
-  m_particleDataForGPUs[particle.GetGPUData()].m_particleTransform.pos(position);
+    // every particle spawns with the emitter's rotational velocity, so either all of them
+    // spin or all of them face their direction of movement
+  features |= pEmitterData.m_rotationalVelocity ? ParticleKernels::uf_spinning : ParticleKernels::uf_facing;
 
-    // setting rotation
-  m_particleDataForGPUs[particle.GetGPUData()].m_particleTransform.Rot(pTransform.Rot());
+  if (pEmitterData.m_fixedTimeStep > 0.0f)
+    features |= ParticleKernels::uf_fixedStep;
 
-    // setting initial color
-  m_particleDataForGPUs[particle.GetGPUData()].m_particleColor = m_emitterData.m_initialColor;
+  return features;
+}
 
-    // setting random angle
-  float RandomAngle = 0.0f;
+void particleEmitter::UpdateParticleEmitterWaveTiming(float dt)
+{
+  ParticleEmitterCommon::UpdateWaveTiming(m_emitterData, dt, m_isEmitterActive, m_currentWaveTime, m_isEmitterPaused);
+}
 
-  if (m_emitterData.m_randomAngleRange)
-    RandomAngle = ScalarTools::RandomRange(-m_emitterData.m_randomAngleRange, m_emitterData.m_randomAngleRange);
+void particleEmitter::SpawnParticles(const transform& pTransform)
+{
+    // time doesn't pile up while the emitter isn't spawning, otherwise it would spit out
+    // a burst of particles once it starts again
+  if (!m_isEmitterActive || m_isEmitterPaused)
+  {
+    m_timesSinceLastParticleSpawned = 0.0f;
+    return;
+  }
+
+  PARTICLE_PROFILE_PHASE(m_profile, pp_spawn);
 
-    // setting random initial and final scale
-  particle.GetRandomScale()[0] = m_emitterData.m_initialScale + ScalarTools::RandomRange(-m_emitterData.m_randomScaleFactor, m_emitterData.m_randomScaleFactor);
-  particle.GetRandomScale()[1] = m_emitterData.m_finalScale + ScalarTools::RandomRange(-m_emitterData.m_randomScaleFactor, m_emitterData.m_randomScaleFactor);
-  m_particleDataForGPUs[particle.GetGPUData()].m_particleTransform.Scl(particle.GetRandomScale()[0]);
+  unsigned dueCount = ParticleEmitterCommon::TakeDueParticles(m_timesSinceLastParticleSpawned, m_timeBetweenParticles);
 
-    // setting random lifetime
-  float randomLifetime = 0.0f;
-  if (m_emitterData.m_randomParticleLifetimeRange)
-    randomLifetime = ScalarTools::RandomRange(0.0f, m_emitterData.m_randomParticleLifetimeRange);
-  particle.GetTotalLifetime() = m_emitterData.m_totalParticleLifetime + randomLifetime;
+    // particles that don't fit in the pool (or under the cap of the level of detail) are
+    // dropped
+  unsigned particleCap = static_cast<unsigned>(m_particles.size() * m_lodParticleCapScale);
+  particleCap = (particleCap < m_particles.size()) ? particleCap : m_particles.size();
+  unsigned freeCount = (particleCap > m_liveParticleCount) ? particleCap - m_liveParticleCount : 0;
+  unsigned spawnCount = (dueCount < freeCount) ? dueCount : freeCount;
 
-  vector4 initialVelocity;
-  initialVelocity.x = cosf(m_emitterData.m_initialAngle + RandomAngle) * m_emitterData.m_initialVelocity;
-  initialVelocity.y = sinf(m_emitterData.m_initialAngle + RandomAngle) * m_emitterData.m_initialVelocity;
-  particle.SetVelocity(initialVelocity);
+  unsigned capacity = m_particles.size();
+
+  while (spawnCount)
+  {
+    unsigned batchCount = (spawnCount < ParticleEmitterCommon::c_spawnBatchSize) ? spawnCount : ParticleEmitterCommon::c_spawnBatchSize;
 
-    // setting the initial angular velocity
-  particle.SetAngularVelocity(m_emitterData.m_rotationalVelocity);
+      // new particles go right after the last active one, which can wrap around the end
+      // of a ring buffer
+    unsigned first = m_liveParticleCount;
+    if (m_isRingBuffer)
+      first = (m_ringStart + m_liveParticleCount) % capacity;
+
+    unsigned firstSpanCount = (first + batchCount <= capacity) ? batchCount : capacity - first;
+    particleSpan spans[2] = { { first, first + firstSpanCount }, { 0, batchCount - firstSpanCount } };
+    ParticleEmitterCommon::SpawnParticleBatch(m_particles, spans, m_emitterData, m_random, pTransform);
+
+    m_liveParticleCount += batchCount;
+    PARTICLE_PROFILE_COUNT(m_profile, pc_spawns, batchCount);
+    spawnCount -= batchCount;
+  }
 }
 
-  // using simple euler intergration to calculate new positions and velocities
-void particleEmitter::UpdateParticlePhysics(const vector4& accumulatedForce, particle& particle, float dt)
+void particleEmitter::SetJobSystem(particleJobSystem* pJobSystem)
 {
-    // incrementing velocity
-  vector4 newVelocity = particle.GetVelocity();
-  newVelocity += accumulatedForce * (dt / 2.0f) + particle.GetForce();
-  float newAngularVelocity = particle.GetAngularVelocity();
-
-    // setting the new incremented velocity
-  particle.SetVelocity(newVelocity);
-  particle.SetAngularVelocity(newAngularVelocity);
+  m_jobSystem = pJobSystem;
+}
 
-    // incrementing position with respect to the new incremented velocity
-  vector4 newPosition = m_particleDataForGPUs[particle.GetGPUData()].m_particleTransform.pos();
-  newPosition += particle.GetVelocity() * dt;
+void particleEmitter::SetScheduler(particleEmitterScheduler* pScheduler)
+{
+  m_scheduler = pScheduler;
+}
 
-  float newRotation = m_particleDataForGPUs[particle.GetGPUData()].m_particleTransform.Rot();;
-  newRotation += particle.GetAngularVelocity() * dt;
+void particleEmitter::SetParent(particleEmitterBundle* pParent)
+{
+  m_parent = pParent;
+}
 
-    // setting old transform
-  particle.GetOldPosition() = m_particleDataForGPUs[particle.GetGPUData()].m_particleTransform.pos();
+#ifdef PARTICLE_PROFILING
+const particleFrameStats& particleEmitter::GetFrameStats() const
+{
+  return m_profile.GetLastFrame();
+}
+#endif
 
-    // setting the new position and rotation values
-  m_particleDataForGPUs[particle.GetGPUData()].m_particleTransform.pos(newPosition);
-  m_particleDataForGPUs[particle.GetGPUData()].m_particleTransform.Rot(newRotation);
+bool particleEmitter::IsDormant() const
+{
+  return !m_isEmitterActive && !m_liveParticleCount;
+}
 
-  if (!particle.GetAngularVelocity())
-    m_particleDataForGPUs[particle.GetGPUData()].m_particleTransform.Rot(atan2f(newVelocity.y, newVelocity.x));
+void particleEmitter::GetBounds(const transform& pTransform, float pBounds[4]) const
+{
+  float lifetime = m_emitterData.m_totalParticleLifetime + m_emitterData.m_randomParticleLifetimeRange;
+  const vector4& constantAcceleration = m_emitterData.m_constantAcceleration;
+  float acceleration = sqrtf(constantAcceleration.x * constantAcceleration.x + constantAcceleration.y * constantAcceleration.y);
+  float biggestScale = ((m_emitterData.m_initialScale > m_emitterData.m_finalScale) ? m_emitterData.m_initialScale : m_emitterData.m_finalScale) +
+    fabsf(m_emitterData.m_randomScaleFactor);
+
+    // furthest a particle can get flying straight out and speeding up the whole way
+  float reach = fabsf(m_emitterData.m_initialVelocity) * lifetime + acceleration * lifetime * lifetime / 2.0f + biggestScale;
+  float reachX = fabsf(m_emitterData.m_randomPositionRange.x) + reach;
+  float reachY = fabsf(m_emitterData.m_randomPositionRange.y) + reach;
+
+  vector4 spawnPosition = pTransform.pos() + m_emitterData.m_offset;
+  pBounds[0] = spawnPosition.x - reachX;
+  pBounds[1] = spawnPosition.y - reachY;
+  pBounds[2] = spawnPosition.x + reachX;
+  pBounds[3] = spawnPosition.y + reachY;
+
+    // analytic particles are stored as they spawned, so they can still be anywhere within
+    // the reach of where they are. the others are where they are, give or take their size
+  float padding = m_isAnalytic ? reach : biggestScale;
+
+  particleSpan liveSpans[2];
+  unsigned liveSpanCount = GetLiveSpans(liveSpans);
+
+  for (unsigned span = 0; span < liveSpanCount; ++span)
+  {
+    float liveBounds[4];
+    ParticleKernels::ComputeBounds(m_particles, liveSpans[span].m_begin, liveSpans[span].m_end, liveBounds);
 
-  particle.GetForce().Clear();
+    pBounds[0] = (liveBounds[0] - padding < pBounds[0]) ? liveBounds[0] - padding : pBounds[0];
+    pBounds[1] = (liveBounds[1] - padding < pBounds[1]) ? liveBounds[1] - padding : pBounds[1];
+    pBounds[2] = (liveBounds[2] + padding > pBounds[2]) ? liveBounds[2] + padding : pBounds[2];
+    pBounds[3] = (liveBounds[3] + padding > pBounds[3]) ? liveBounds[3] + padding : pBounds[3];
+  }
 }
 
-void particleEmitter::CreateParticle(const transform& pTransform)
+void particleEmitter::SetCameraDistance(float pDistance)
 {
-  shaderHandler::gPUData data; // new data for particle
-  m_particleDataForGPUs.push_back(data); // adding the data to the vector of gpu particle data
-  particle newParticle(static_cast<unsigned>(m_particleDataForGPUs.size() - 1)); // constructing the particle
-  m_particles.push_back(newParticle); // adding new particle to the vector of particles
+  const std::vector<emitterLOD>& tiers = m_emitterData.m_lodTiers;
 
-    // reset particle sets all the position and velocity data with respect to the random values and stuff
-  ResetParticle(m_particles[m_particles.size() - 1], pTransform);
+    // closer than the first tier is full detail
+  m_lodSpawnRateScale = m_lodParticleCapScale = 1.0f;
+  m_lodUpdateInterval = 1;
+  m_lodCollides = true;
+
+  for (unsigned i = 0; (i < tiers.size()) && (pDistance >= tiers[i].m_distance); ++i)
+  {
+      // fading from wherever the tiers before ended up into this one, so tiers closer
+      // together than the blend distance don't jump either
+    float previousSpawnRateScale = m_lodSpawnRateScale;
+    float previousParticleCapScale = m_lodParticleCapScale;
+
+    float blend = 1.0f;
+    if (m_emitterData.m_lodBlendDistance > 0.0f)
+      blend = (pDistance - tiers[i].m_distance) / m_emitterData.m_lodBlendDistance;
+    blend = (blend < 1.0f) ? blend : 1.0f;
+
+    m_lodSpawnRateScale = previousSpawnRateScale + (tiers[i].m_spawnRateScale - previousSpawnRateScale) * blend;
+    m_lodParticleCapScale = previousParticleCapScale + (tiers[i].m_particleCapScale - previousParticleCapScale) * blend;
+    m_lodUpdateInterval = tiers[i].m_updateInterval ? tiers[i].m_updateInterval : 1;
+    m_lodCollides = tiers[i].m_collides;
+  }
 }
 
 void particleEmitter::AddForceToSystem(const vector4& pForce)
@@ -280,16 +459,67 @@ void particleEmitter::AddForceToSystem(const vector4& pForce)
   m_additionalForce += pForce; // works like force-impulse system
 }
 
-std::vector<shaderHandler::gPUData>& particleEmitter::GetGPUData()
+particleGPUDataVector& particleEmitter::GetGPUData()
 {
   return m_particleDataForGPUs;
 }
 
-std::vector<particle>& particleEmitter::GetParticles()
+const shaderHandler::gPUData* particleEmitter::GetLiveGPUData(unsigned& pCount) const
+{
+  pCount = (m_gpuRing || m_gpuDataFormat == gdf_packed) ? 0 : m_liveParticleCount;
+  return m_particleDataForGPUs.data();
+}
+
+void particleEmitter::SetGPURing(particleGPURing* pRing)
+{
+  m_gpuRing = pRing;
+}
+
+void particleEmitter::SetGPUDataFormat(particleGPUDataFormat pFormat)
+{
+  m_gpuDataFormat = pFormat;
+
+    // only packed emitters hold on to packed data
+  if (pFormat == gdf_packed)
+    m_packedGPUData.resize(m_particles.size());
+  else
+    particlePackedDataVector(m_packedGPUData.get_allocator()).swap(m_packedGPUData);
+}
+
+void particleEmitter::SetDepthSort(particleDepthSortMode pMode)
+{
+  m_depthSortMode = pMode;
+  m_depthSort.Invalidate();
+}
+
+const unsigned* particleEmitter::GetDrawOrder(unsigned& pCount) const
+{
+  pCount = (m_depthSortMode != dsm_none) ? m_depthSort.size() : 0;
+  return m_depthSort.GetOrder();
+}
+
+particleGPUDataFormat particleEmitter::GetGPUDataFormat() const
+{
+  return m_gpuDataFormat;
+}
+
+const ParticleKernels::packedParticle* particleEmitter::GetPackedGPUData(unsigned& pCount, vector4& pOrigin) const
+{
+  pCount = (m_gpuDataFormat == gdf_packed) ? m_liveParticleCount : 0;
+  pOrigin = m_gpuDataOrigin;
+  return m_packedGPUData.data();
+}
+
+particleStorage& particleEmitter::GetParticles()
 {
   return m_particles;
 }
 
+particleRandom& particleEmitter::GetRandom()
+{
+  return m_random;
+}
+
 emitterData& particleEmitter::GetEmitterData()
 {
   return m_emitterData;
@@ -300,42 +530,148 @@ void particleEmitter::ResetTimeBetweenParticles()
   m_timeBetweenParticles = 1.0f / (float)m_emitterData.m_particlesPerSecond;
 }
 
-void particleEmitter::SwapWithLastActiveParticle(particle& pParticle)
+renderer& particleEmitter::GetEmitterRenderer()
 {
-  particle& lastActive = m_particles[m_liveParticleCount - 1];
+  return m_emitterData.m_particleRenderer;
+}
 
-    // swap gpu data itself
-  std::swap(m_particleDataForGPUs[pParticle.GetGPUData()], m_particleDataForGPUs[lastActive.GetGPUData()]);
+unsigned particleEmitter::GetLiveParticleCount() const
+{
+  return m_liveParticleCount;
+}
 
-    // swap gpu data index in the particle
-  std::swap(pParticle.GetGPUData(), lastActive.GetGPUData());
+unsigned particleEmitter::GetLiveSpans(particleSpan pSpans[2]) const
+{
+  if (!m_liveParticleCount)
+    return 0;
 
-    // swap particles
-  std::swap(pParticle, m_particles[m_liveParticleCount - 1]);
+  if (!m_isRingBuffer)
+  {
+    pSpans[0].m_begin = 0;
+    pSpans[0].m_end = m_liveParticleCount;
+    return 1;
+  }
+
+    // the active particles of a ring buffer can wrap around the end of the storage
+  unsigned capacity = m_particles.size();
+  unsigned end = m_ringStart + m_liveParticleCount;
+
+  pSpans[0].m_begin = m_ringStart;
+  pSpans[0].m_end = (end < capacity) ? end : capacity;
+  if (end <= capacity)
+    return 1;
+
+  pSpans[1].m_begin = 0;
+  pSpans[1].m_end = end - capacity;
+  return 2;
 }
 
-void particleEmitter::SwapWithFirstInactiveParticle(particle& pParticle)
+unsigned particleEmitter::ClipLiveSpans(particleSpan pSpans[2], unsigned pCount) const
 {
-  particle& firstInactive = m_particles[m_liveParticleCount];
+  unsigned spanCount = GetLiveSpans(pSpans);
 
-    // swap GPU data itself
-  std::swap(m_particleDataForGPUs[pParticle.GetGPUData()], m_particleDataForGPUs[firstInactive.GetGPUData()]);
+    // the oldest particles are kept, like when the pool shrinks
+  for (unsigned span = 0; span < spanCount; ++span)
+  {
+    unsigned length = pSpans[span].m_end - pSpans[span].m_begin;
+    if (length >= pCount)
+    {
+      pSpans[span].m_end = pSpans[span].m_begin + pCount;
+      return pCount ? span + 1 : span;
+    }
 
-    // swap gpu data index in the particle
-  std::swap(pParticle.GetGPUData(), firstInactive.GetGPUData());
+    pCount -= length;
+  }
 
-    // swap particles
-  std::swap(pParticle, m_particles[m_liveParticleCount]);
+  return spanCount;
 }
 
-renderer& particleEmitter::GetEmitterRenderer()
+bool particleEmitter::IsRingBuffer() const
 {
-  return m_emitterData.m_particleRenderer;
+  return m_isRingBuffer;
 }
 
-unsigned particleEmitter::GetLiveParticleCount() const
+bool particleEmitter::IsAnalytic() const
 {
-  return m_liveParticleCount;
+  return m_isAnalytic;
+}
+
+bool particleEmitter::EvaluateGPUData(float pTimeOffset)
+{
+  return EvaluateGPUData(pTimeOffset, m_particleDataForGPUs.data(), static_cast<unsigned>(m_particleDataForGPUs.size()));
+}
+
+bool particleEmitter::EvaluateGPUData(float pTimeOffset, shaderHandler::gPUData* pGPUData, unsigned pCount)
+{
+  if (!m_isAnalytic)
+    return false;
+
+    // same layout as WriteGPUData, the active particles go to [0, live count)
+  particleSpan liveSpans[2];
+  unsigned liveSpanCount = ClipLiveSpans(liveSpans, pCount);
+  unsigned gpuDataOffset = 0;
+
+  ParticleKernels::evaluateParameters parameters = { m_emitterData.m_constantAcceleration, m_emitterData.m_initialColor, m_emitterData.m_finalColor, pTimeOffset };
+
+  for (unsigned span = 0; span < liveSpanCount; ++span)
+  {
+    unsigned gpuDataShift = gpuDataOffset - liveSpans[span].m_begin;
+
+    ParticleEmitterCommon::RunInChunks(m_jobSystem, liveSpans[span].m_begin, liveSpans[span].m_end, [this, pGPUData, gpuDataShift, &parameters](unsigned pBegin, unsigned pEnd)
+    {
+        // evaluated into columns a batch at a time, then copied into the gpu data
+      float positionX[c_packBatchSize], positionY[c_packBatchSize], rotation[c_packBatchSize], scale[c_packBatchSize];
+      float colorR[c_packBatchSize], colorG[c_packBatchSize], colorB[c_packBatchSize], colorA[c_packBatchSize];
+      ParticleKernels::evaluatedColumns columns = { positionX, positionY, rotation, scale, colorR, colorG, colorB, colorA };
+
+      for (unsigned batchBegin = pBegin; batchBegin < pEnd; batchBegin += c_packBatchSize)
+      {
+        unsigned batchCount = (pEnd - batchBegin < c_packBatchSize) ? pEnd - batchBegin : c_packBatchSize;
+        ParticleKernels::EvaluateParticles(m_particles, batchBegin, batchBegin + batchCount, parameters, columns);
+
+        for (unsigned batchIndex = 0; batchIndex < batchCount; ++batchIndex)
+        {
+          unsigned i = batchBegin + batchIndex;
+
+          shaderHandler::gPUData& gpuData = pGPUData[i + gpuDataShift];
+          gpuData.m_particleTransform.pos(vector4(positionX[batchIndex], positionY[batchIndex], m_particles.m_positionZ[i]));
+          gpuData.m_particleTransform.Rot(rotation[batchIndex]);
+          gpuData.m_particleTransform.Scl(scale[batchIndex]);
+
+          gpuData.m_particleColor = vector4(colorR[batchIndex], colorG[batchIndex], colorB[batchIndex], colorA[batchIndex]);
+        }
+      }
+    });
+
+    gpuDataOffset += liveSpans[span].m_end - liveSpans[span].m_begin;
+  }
+
+  return true;
+}
+
+void particleEmitter::KillOldestParticles()
+{
+  unsigned capacity = m_particles.size();
+
+    // the oldest particle always dies first, so stop at the first one still alive
+  while (m_liveParticleCount && (m_particles.m_currentLifetime[m_ringStart] > m_particles.m_totalLifetime[m_ringStart]))
+  {
+    m_particles.m_isActive[m_ringStart] = false;
+    m_ringStart = (m_ringStart + 1) % capacity;
+    --m_liveParticleCount;
+    PARTICLE_PROFILE_COUNT(m_profile, pc_deaths, 1);
+  }
+
+  if (!m_liveParticleCount)
+    m_ringStart = 0;
+}
+
+void particleEmitter::StopRingBuffer()
+{
+  m_particles.Rotate(m_ringStart);
+  m_depthSort.Invalidate();
+  m_ringStart = 0;
+  m_isRingBuffer = false;
 }
 
 void particleEmitter::RestartEmitter()
@@ -347,6 +683,10 @@ void particleEmitter::RestartEmitter()
 
   m_isEmitterPaused = false;
   m_isEmitterActive = true;
+
+    // a sleeping emitter has to be updated again
+  if (m_scheduler)
+    m_scheduler->WakeEmitter(*this);
 }
 
 void particleEmitter::StopEmitter()
@@ -356,90 +696,607 @@ void particleEmitter::StopEmitter()
 
 void particleEmitter::CheckParticleCollisions(transform& colliderTransform, collider& interactableCollider)
 {
-  if (interactableCollider.GetType() == collider::ct_polygon)
-    ParticlePolygonCollisions(colliderTransform, dynamic_cast<colliderPolygon&>(interactableCollider));
+  particleCollider singleCollider = { &interactableCollider, &colliderTransform, nullptr };
+  CheckParticleCollisions(&singleCollider, 1);
 }
 
-void particleEmitter::ParticlePolygonCollisions(transform& colliderTransform, colliderPolygon& interactableCollider)
+void particleEmitter::CheckParticleCollisions(const particleCollider* pColliders, unsigned pColliderCount)
 {
-  polygon& interactablePoly = dynamic_cast<polygon&>(interactableCollider.GetColliderShape());
+    // analytic particles don't collide (they only become interactable on the next update)
+  if (m_isAnalytic || !m_liveParticleCount || !m_lodCollides)
+    return;
 
-  const std::vector<vector4>& vertices = interactablePoly.GetVertexList(); //list
-  const std::vector<vector4>& normals = interactablePoly.GetNormalList();
+  m_colliderVertices.clear();
+  m_colliderPlanes.clear();
+  m_polygonColliders.clear();
+  m_circleColliders.clear();
+  m_fieldColliders.clear();
 
-  for (auto& currentParticle : m_particles)
+    // the type is already known, so there's no need for a dynamic_cast
+  for (unsigned i = 0; i < pColliderCount; ++i)
   {
-    if (!currentParticle.IsActive())
-      break;
+    if (pColliders[i].m_distanceField && !m_emitterData.m_useExactCollisions)
+    {
+      fieldCollider bakedCollider;
+      bakedCollider.m_field = pColliders[i].m_distanceField;
+      bakedCollider.m_field->GetBounds(bakedCollider.m_bounds);
+      bakedCollider.m_velocity = pColliders[i].m_collider->GetPhysicsComponent()->GetRigidBodyComponent()->GetVelocity();
+      m_fieldColliders.push_back(bakedCollider);
+    }
+    else if (pColliders[i].m_collider->GetType() == collider::ct_polygon)
+      PreparePolygonCollider(*pColliders[i].m_transform, static_cast<colliderPolygon&>(*pColliders[i].m_collider));
+    else if (pColliders[i].m_collider->GetType() == collider::ct_circle)
+      PrepareCircleCollider(*pColliders[i].m_transform, static_cast<colliderCircle&>(*pColliders[i].m_collider));
+  }
 
-    vector4 currentPosition = m_particleDataForGPUs[currentParticle.GetGPUData()].m_particleTransform.pos();
-    int intersectingIndex = INT_MAX;
+    // the planes only stop moving once every collider is added
+  for (polygonCollider& worldPolygon : m_polygonColliders)
+    worldPolygon.m_planes.m_planes = m_colliderPlanes.data() + worldPolygon.m_firstFace * 3;
+
+  ResolvePreparedCollisions();
+}
 
-    bool isInsideCollider = true;
-    for (int i = 0; i < vertices.size(); ++i)
+void particleEmitter::ResolvePreparedCollisions()
+{
+  if (m_isAnalytic || !m_liveParticleCount || !m_lodCollides)
+    return;
+
+  if (m_polygonColliders.empty() && m_circleColliders.empty() && m_fieldColliders.empty())
+    return;
+
+  PARTICLE_PROFILE_PHASE(m_profile, pp_collision);
+
+  particleSpan liveSpans[2];
+  unsigned liveSpanCount = GetLiveSpans(liveSpans);
+
+    // every batch of particles is checked against all colliders while it's in the cache
+  for (unsigned span = 0; span < liveSpanCount; ++span)
+  {
+    for (unsigned batchBegin = liveSpans[span].m_begin; batchBegin < liveSpans[span].m_end; batchBegin += c_collisionBatchSize)
     {
-        // getting the face in world space
-      vector4 currentFace[2];
-      currentFace[0] = colliderTransform.GetLinearTransformation() * vertices[i] + colliderTransform.pos();
-      currentFace[1] = colliderTransform.GetLinearTransformation() * vertices[(i + 1) % vertices.size()] + colliderTransform.pos();
+      unsigned batchEnd = (batchBegin + c_collisionBatchSize < liveSpans[span].m_end) ? batchBegin + c_collisionBatchSize : liveSpans[span].m_end;
+
+      float batchBounds[4];
+      ParticleKernels::ComputeBounds(m_particles, batchBegin, batchEnd, batchBounds);
+
+      for (const polygonCollider& worldPolygon : m_polygonColliders)
+      {
+          // colliders that aren't near the batch are skipped
+        if ((batchBounds[2] < worldPolygon.m_planes.m_minX) || (batchBounds[0] > worldPolygon.m_planes.m_maxX) ||
+            (batchBounds[3] < worldPolygon.m_planes.m_minY) || (batchBounds[1] > worldPolygon.m_planes.m_maxY))
+          continue;
 
-        // transformed normal of the face
-      vector4 normalFace = colliderTransform.GetLinearTransformation() * normals[i];
+          // only the particles inside the collider need to be resolved
+        unsigned insideParticles[c_collisionBatchSize];
+        unsigned insideCount = ParticleKernels::FindParticlesInPolygon(m_particles, batchBegin, batchEnd, worldPolygon.m_planes, insideParticles);
+        PARTICLE_PROFILE_COUNT(m_profile, pc_collisionTests, batchEnd - batchBegin);
 
-      float d = normalFace * currentFace[0]; // calculating "d" for the half place
-      vector4 halfPlane = vector4(normalFace.x, normalFace.y, -d);
-      vector4 homoParticlePos = vector4(currentPosition.x, currentPosition.y, 1);
+        ResolvePolygonCollisions(worldPolygon, insideParticles, insideCount);
+      }
+
+      for (const fieldCollider& bakedCollider : m_fieldColliders)
+      {
+          // colliders that aren't near the batch are skipped
+        if ((batchBounds[2] < bakedCollider.m_bounds[0]) || (batchBounds[0] > bakedCollider.m_bounds[2]) ||
+            (batchBounds[3] < bakedCollider.m_bounds[1]) || (batchBounds[1] > bakedCollider.m_bounds[3]))
+          continue;
 
-      float dot = homoParticlePos.dotProduct3x3(halfPlane);
+          // only the particles inside the collider need to be resolved
+        unsigned insideParticles[c_collisionBatchSize];
+        unsigned insideCount = bakedCollider.m_field->FindInside(m_particles.m_positionX, m_particles.m_positionY, batchBegin, batchEnd, insideParticles);
+        PARTICLE_PROFILE_COUNT(m_profile, pc_collisionTests, batchEnd - batchBegin);
 
-      if (dot > 0)
+        ResolveFieldCollisions(bakedCollider, insideParticles, insideCount);
+      }
+
+      for (const circleCollider& worldCircle : m_circleColliders)
       {
-          // outside the half plane
-        isInsideCollider = false;
-        break;
+        const ParticleKernels::circleShape& circle = worldCircle.m_circle;
+
+          // colliders that aren't near the batch are skipped
+        if ((batchBounds[2] < circle.m_centerX - circle.m_radius) || (batchBounds[0] > circle.m_centerX + circle.m_radius) ||
+            (batchBounds[3] < circle.m_centerY - circle.m_radius) || (batchBounds[1] > circle.m_centerY + circle.m_radius))
+          continue;
+
+        unsigned insideParticles[c_collisionBatchSize];
+        unsigned insideCount = ParticleKernels::FindParticlesInCircle(m_particles, batchBegin, batchEnd, circle, insideParticles);
+        PARTICLE_PROFILE_COUNT(m_profile, pc_collisionTests, batchEnd - batchBegin);
+
+        ResolveCircleCollisions(worldCircle, insideParticles, insideCount);
       }
+    }
+  }
+}
 
-        // checking if particle intersected with current line
-      vector4 directionVector = currentParticle.GetOldPosition() - currentPosition;
-      directionVector.Normalize();
-      directionVector *= 0.2f;
+void particleEmitter::PreparePolygonCollider(transform& colliderTransform, colliderPolygon& interactableCollider)
+{
+  polygon& interactablePoly = static_cast<polygon&>(interactableCollider.GetColliderShape());
+
+  const std::vector<vector4>& vertices = interactablePoly.GetVertexList(); //list
+  const std::vector<vector4>& normals = interactablePoly.GetNormalList();
+
+  unsigned faceCount = static_cast<unsigned>(vertices.size());
+  if (!faceCount)
+    return;
+
+  polygonCollider worldPolygon;
+  worldPolygon.m_firstFace = static_cast<unsigned>(m_colliderVertices.size());
+  worldPolygon.m_planes.m_planes = nullptr;
+  worldPolygon.m_planes.m_planeCount = faceCount;
+
+    // rigid body velocity is the same for every particle that hits the collider
+  worldPolygon.m_velocity = interactableCollider.GetPhysicsComponent()->GetRigidBodyComponent()->GetVelocity();
+
+    // getting the faces in world space once for all particles
+  for (unsigned i = 0; i < faceCount; ++i)
+    m_colliderVertices.push_back(colliderTransform.GetLinearTransformation() * vertices[i] + colliderTransform.pos());
+
+  const vector4* worldVertices = m_colliderVertices.data() + worldPolygon.m_firstFace;
+  worldPolygon.m_planes.m_minX = worldPolygon.m_planes.m_maxX = worldVertices[0].x;
+  worldPolygon.m_planes.m_minY = worldPolygon.m_planes.m_maxY = worldVertices[0].y;
+
+  for (unsigned i = 0; i < faceCount; ++i)
+  {
+      // transformed normal of the face and "d" for the half plane
+    vector4 normalFace = colliderTransform.GetLinearTransformation() * normals[i];
+    m_colliderPlanes.push_back(normalFace.x);
+    m_colliderPlanes.push_back(normalFace.y);
+    m_colliderPlanes.push_back(normalFace * worldVertices[i]);
+
+    worldPolygon.m_planes.m_minX = (worldVertices[i].x < worldPolygon.m_planes.m_minX) ? worldVertices[i].x : worldPolygon.m_planes.m_minX;
+    worldPolygon.m_planes.m_minY = (worldVertices[i].y < worldPolygon.m_planes.m_minY) ? worldVertices[i].y : worldPolygon.m_planes.m_minY;
+    worldPolygon.m_planes.m_maxX = (worldVertices[i].x > worldPolygon.m_planes.m_maxX) ? worldVertices[i].x : worldPolygon.m_planes.m_maxX;
+    worldPolygon.m_planes.m_maxY = (worldVertices[i].y > worldPolygon.m_planes.m_maxY) ? worldVertices[i].y : worldPolygon.m_planes.m_maxY;
+  }
+
+  m_polygonColliders.push_back(worldPolygon);
+}
+
+void particleEmitter::PrepareCircleCollider(transform& colliderTransform, colliderCircle& interactableCollider)
+{
+  circle& interactableCircle = static_cast<circle&>(interactableCollider.GetColliderShape());
 
-      vector4 IntersectingPoint = CollisionDetect::LineIntersection(currentFace[0], currentFace[1], currentPosition, currentPosition + directionVector);
+    // the circle is scaled by the bigger side of the transform, like the polygon's vertices
+  float scaleX = fabsf(colliderTransform.Scl().x);
+  float scaleY = fabsf(colliderTransform.Scl().y);
+
+  circleCollider worldCircle;
+  worldCircle.m_circle.m_centerX = colliderTransform.pos().x;
+  worldCircle.m_circle.m_centerY = colliderTransform.pos().y;
+  worldCircle.m_circle.m_radius = interactableCircle.GetRadius() * ((scaleX > scaleY) ? scaleX : scaleY);
+  worldCircle.m_velocity = interactableCollider.GetPhysicsComponent()->GetRigidBodyComponent()->GetVelocity();
+
+  m_circleColliders.push_back(worldCircle);
+}
+
+void particleEmitter::ResolveCircleCollisions(const circleCollider& pCircle, const unsigned* pParticles, unsigned pCount)
+{
+  const ParticleKernels::circleShape& circle = pCircle.m_circle;
+  float radiusSquared = circle.m_radius * circle.m_radius;
+
+  for (unsigned inside = 0; inside < pCount; ++inside)
+  {
+    unsigned i = pParticles[inside];
+
+    float offsetX = m_particles.m_positionX[i] - circle.m_centerX;
+    float offsetY = m_particles.m_positionY[i] - circle.m_centerY;
+    float distance = sqrtf(offsetX * offsetX + offsetY * offsetY);
+
+      // looking a little bit back along the particle's path, like the polygons do
+    float directionX = m_particles.m_oldPositionX[i] - m_particles.m_positionX[i];
+    float directionY = m_particles.m_oldPositionY[i] - m_particles.m_positionY[i];
+    float directionLength = sqrtf(directionX * directionX + directionY * directionY);
+    if ((distance <= 0.0f) || (directionLength <= 0.0f))
+      continue;
+
+    float backX = offsetX + directionX * (0.2f / directionLength);
+    float backY = offsetY + directionY * (0.2f / directionLength);
+
+      // particle is too far inside the collider, just don't worry about it
+    if (backX * backX + backY * backY <= radiusSquared)
+      continue;
+
+      // pushing the particle out along the normal of the circle where it entered, with the
+      // same random restitution as the polygons (only drawn for the particles that bounce)
+    ReflectParticle(i, vector4(offsetX / distance, offsetY / distance), pCircle.m_velocity, m_random.Range(-0.2f, 0.2f));
+  }
+}
+
+void particleEmitter::ResolveFieldCollisions(const fieldCollider& pField, const unsigned* pParticles, unsigned pCount)
+{
+  const particleDistanceField& field = *pField.m_field;
+
+  for (unsigned inside = 0; inside < pCount; ++inside)
+  {
+    unsigned i = pParticles[inside];
+
+      // the gradient is only looked up for the particles inside
+    float normalX, normalY;
+    field.GetDistance(m_particles.m_positionX[i], m_particles.m_positionY[i], normalX, normalY);
+
+      // looking a little bit back along the particle's path, like the polygons do
+    float directionX = m_particles.m_oldPositionX[i] - m_particles.m_positionX[i];
+    float directionY = m_particles.m_oldPositionY[i] - m_particles.m_positionY[i];
+    float directionLength = sqrtf(directionX * directionX + directionY * directionY);
+    if ((directionLength <= 0.0f) || (!normalX && !normalY))
+      continue;
+
+      // particle is too far inside the collider, just don't worry about it
+    float backX = m_particles.m_positionX[i] + directionX * (0.2f / directionLength);
+    float backY = m_particles.m_positionY[i] + directionY * (0.2f / directionLength);
+    if (field.GetDistance(backX, backY) <= 0.0f)
+      continue;
+
+      // pushing the particle out along the gradient of the field, with the same random
+      // restitution as the polygons (only drawn for the particles that bounce)
+    ReflectParticle(i, vector4(normalX, normalY), pField.m_velocity, m_random.Range(-0.2f, 0.2f));
+  }
+}
+
+void particleEmitter::ResolvePolygonCollisions(const polygonCollider& pPolygon, const unsigned* pParticles, unsigned pCount)
+{
+  const vector4* worldVertices = m_colliderVertices.data() + pPolygon.m_firstFace;
+  unsigned faceCount = pPolygon.m_planes.m_planeCount;
+
+  for (unsigned inside = 0; inside < pCount; ++inside)
+  {
+    unsigned particleIndex = pParticles[inside];
+    particle currentParticle = m_particles[particleIndex];
+
+    vector4 currentPosition = currentParticle.GetPosition();
+    int intersectingIndex = INT_MAX;
+
+      // checking which line the particle went through
+    vector4 directionVector = currentParticle.GetOldPosition() - currentPosition;
+    directionVector.Normalize();
+    directionVector *= 0.2f;
+
+    for (unsigned i = 0; i < faceCount; ++i)
+    {
+      vector4 IntersectingPoint = CollisionDetect::LineIntersection(worldVertices[i], worldVertices[(i + 1) % faceCount], currentPosition, currentPosition + directionVector);
       if (IntersectingPoint != currentPosition + directionVector)
       {
         intersectingIndex = i;
       }
     }
 
-      // we know we have to resolve the particle collision
-    if (isInsideCollider)
+      // particle is too far inside the collider, just don't worry about it
+    if (intersectingIndex >= static_cast<int>(faceCount))
+      continue;
+
+    vector4 normal = vector4(pPolygon.m_planes.m_planes[intersectingIndex * 3], pPolygon.m_planes.m_planes[intersectingIndex * 3 + 1]);
+    normal.Normalize();
+    ReflectParticle(particleIndex, normal, pPolygon.m_velocity, m_random.Range(-0.2f, 0.2f));
+  }
+}
+
+void particleEmitter::ReflectParticle(unsigned pIndex, const vector4& pNormal, const vector4& pColliderVelocity, float pRestitutionOffset)
+{
+  float normalX = pNormal.x * 1.2f;
+  float normalY = pNormal.y * 1.2f;
+
+  float relativeVelocityX = pColliderVelocity.x - m_particles.m_velocityX[pIndex];
+  float relativeVelocityY = pColliderVelocity.y - m_particles.m_velocityY[pIndex];
+  float impulseScalar = normalX * relativeVelocityX + normalY * relativeVelocityY;
+
+  float restitution = m_emitterData.m_particleRestistution + pRestitutionOffset;
+
+    // capping the values
+  if (restitution < 0)
+    restitution = 0;
+  if (restitution > 1.0f)
+    restitution = 1.0f;
+
+    // setting the reflected velocity
+  m_particles.m_velocityX[pIndex] = (normalX * impulseScalar + m_particles.m_velocityX[pIndex]) * restitution;
+  m_particles.m_velocityY[pIndex] = (normalY * impulseScalar + m_particles.m_velocityY[pIndex]) * restitution;
+  PARTICLE_PROFILE_COUNT(m_profile, pc_collisionHits, 1);
+}
+
+void particleEmitter::StartAnalyticMode()
+{
+  float accelerationX = m_emitterData.m_constantAcceleration.x;
+  float accelerationY = m_emitterData.m_constantAcceleration.y;
+
+  particleSpan liveSpans[2];
+  unsigned liveSpanCount = GetLiveSpans(liveSpans);
+
+    // running the closed form backwards from the current state
+  for (unsigned span = 0; span < liveSpanCount; ++span)
+  {
+    for (unsigned i = liveSpans[span].m_begin; i < liveSpans[span].m_end; ++i)
     {
-        // particle is too far inside the collider, just don't worry about it
-      if (intersectingIndex >= vertices.size())
-        continue;
+      float age = m_particles.m_currentLifetime[i];
 
-      vector4 relativeVelocity = interactableCollider.GetPhysicsComponent()->GetRigidBodyComponent()->GetVelocity() - currentParticle.GetVelocity();
+      m_particles.m_velocityX[i] -= accelerationX * (age / 2.0f);
+      m_particles.m_velocityY[i] -= accelerationY * (age / 2.0f);
+      m_particles.m_positionX[i] -= m_particles.m_velocityX[i] * age + accelerationX * (age * age / 4.0f);
+      m_particles.m_positionY[i] -= m_particles.m_velocityY[i] * age + accelerationY * (age * age / 4.0f);
+      m_particles.m_rotation[i] -= m_particles.m_angularVelocity[i] * age;
+    }
+  }
 
-      vector4 normal = colliderTransform.GetLinearTransformation() * normals[intersectingIndex];
-      normal.Normalize();
-      normal *= 1.2f;
-      float particleRestitution = m_emitterData.m_particleRestistution + ScalarTools::RandomRange(-0.2f, 0.2f);
-      
-      float ImpulseScalar = normal * relativeVelocity;
-      vector4 Impulse = normal * ImpulseScalar;
+  m_isAnalytic = true;
+}
 
-      vector4 newVelocity = Impulse + currentParticle.GetVelocity();
+void particleEmitter::StopAnalyticMode()
+{
+  const vector4& acceleration = m_emitterData.m_constantAcceleration;
+  ParticleKernels::evaluateParameters parameters = { acceleration, m_emitterData.m_initialColor, m_emitterData.m_finalColor, 0.0f };
 
-      float restitution = particleRestitution;
+  particleSpan liveSpans[2];
+  unsigned liveSpanCount = GetLiveSpans(liveSpans);
 
-        // capping the values
-      if (restitution < 0)
-        restitution = 0;
-      if (restitution > 1.0f)
-        restitution = 1.0f;
+  for (unsigned span = 0; span < liveSpanCount; ++span)
+  {
+    unsigned begin = liveSpans[span].m_begin, end = liveSpans[span].m_end;
+
+      // evaluated in place, the velocity they spawned with is still needed for that
+    ParticleKernels::evaluatedColumns columns = { m_particles.m_positionX + begin, m_particles.m_positionY + begin, m_particles.m_rotation + begin,
+                                                  m_particles.m_scale + begin, m_particles.m_colorR + begin, m_particles.m_colorG + begin,
+                                                  m_particles.m_colorB + begin, m_particles.m_colorA + begin };
+    ParticleKernels::EvaluateParticles(m_particles, begin, end, parameters, columns);
 
-        // setting the reflected velocity
-      currentParticle.SetVelocity(newVelocity * restitution);
+    for (unsigned i = begin; i < end; ++i)
+    {
+      float age = m_particles.m_currentLifetime[i];
+      m_particles.m_velocityX[i] += acceleration.x * (age / 2.0f);
+      m_particles.m_velocityY[i] += acceleration.y * (age / 2.0f);
+      m_particles.m_oldPositionX[i] = m_particles.m_positionX[i];
+      m_particles.m_oldPositionY[i] = m_particles.m_positionY[i];
     }
   }
-}
\ No newline at end of file
+
+  m_isAnalytic = false;
+}
+
+bool particleEmitter::CanBeAnalytic() const
+{
+  return m_emitterData.m_useAnalyticMotion && !m_emitterData.m_isInteractable && !m_emitterData.m_interactsWithSelf;
+}
+
+void particleEmitter::ResolveSelfInteractions()
+{
+    // pushes between particles are timed with the collisions
+  PARTICLE_PROFILE_PHASE(m_profile, pp_collision);
+
+  particleSpan liveSpans[2];
+  unsigned liveSpanCount = GetLiveSpans(liveSpans);
+  if (!liveSpanCount)
+    return;
+
+    // particles are as wide as their scale, so the biggest one decides the cell size
+  float biggestScale = ((m_emitterData.m_initialScale > m_emitterData.m_finalScale) ? m_emitterData.m_initialScale : m_emitterData.m_finalScale)
+                     + fabsf(m_emitterData.m_randomScaleFactor);
+  if (biggestScale <= 0.0f)
+    return;
+
+  m_selfInteractionGrid.Build(m_particles, liveSpans, liveSpanCount, biggestScale);
+
+  float restitution = m_emitterData.m_particleRestistution;
+  if (restitution < 0)
+    restitution = 0;
+  if (restitution > 1.0f)
+    restitution = 1.0f;
+
+    // every particle only writes its own position and force, and the grid has its own copy
+    // of the positions, so the chunks can run at the same time
+  for (unsigned span = 0; span < liveSpanCount; ++span)
+  {
+    ParticleEmitterCommon::RunInChunks(m_jobSystem, liveSpans[span].m_begin, liveSpans[span].m_end, [this, restitution](unsigned pBegin, unsigned pEnd)
+    {
+      for (unsigned i = pBegin; i < pEnd; ++i)
+      {
+        float positionX = m_particles.m_positionX[i];
+        float positionY = m_particles.m_positionY[i];
+        float velocityX = m_particles.m_velocityX[i];
+        float velocityY = m_particles.m_velocityY[i];
+        float radius = m_particles.m_scale[i] * 0.5f;
+        float correctionX = 0.0f;
+        float correctionY = 0.0f;
+        float pushX = 0.0f;
+        float pushY = 0.0f;
+
+        m_selfInteractionGrid.ForEachNeighbor(positionX, positionY, [&](unsigned pOther, float pOtherX, float pOtherY)
+        {
+          float offsetX = positionX - pOtherX;
+          float offsetY = positionY - pOtherY;
+          float distanceSquared = offsetX * offsetX + offsetY * offsetY;
+          float touchingDistance = radius + m_particles.m_scale[pOther] * 0.5f;
+
+          if ((pOther == i) || (distanceSquared >= touchingDistance * touchingDistance))
+            return;
+
+            // particles on top of each other are pushed apart along x, in opposite
+            // directions
+          float distance = 0.0f;
+          float normalX = (i < pOther) ? 1.0f : -1.0f;
+          float normalY = 0.0f;
+          if (distanceSquared > 0.0f)
+          {
+            distance = sqrtf(distanceSquared);
+            normalX = offsetX / distance;
+            normalY = offsetY / distance;
+          }
+
+            // each particle moves out half of the overlap, without speeding up
+          float separation = (touchingDistance - distance) * 0.5f;
+          correctionX += normalX * separation;
+          correctionY += normalY * separation;
+
+            // and bounces off the other one if they're moving towards each other
+          float approachSpeed = (velocityX - m_particles.m_velocityX[pOther]) * normalX + (velocityY - m_particles.m_velocityY[pOther]) * normalY;
+          if (approachSpeed < 0.0f)
+          {
+            float impulse = -approachSpeed * (1.0f + restitution) * 0.5f;
+            pushX += normalX * impulse;
+            pushY += normalY * impulse;
+          }
+        });
+
+        m_particles.m_positionX[i] += correctionX;
+        m_particles.m_positionY[i] += correctionY;
+        m_particles.m_forceX[i] += pushX;
+        m_particles.m_forceY[i] += pushY;
+      }
+    });
+  }
+}
+
+void particleEmitter::ResizeParticlePool(unsigned pCapacity)
+{
+    // the oldest particles are moved to the front first, so the newest ones are dropped
+  m_particles.Rotate(m_ringStart);
+  m_ringStart = 0;
+  m_depthSort.Invalidate();
+
+  unsigned keptCount = (m_liveParticleCount < pCapacity) ? m_liveParticleCount : pCapacity;
+
+  particleStorage resizedParticles(pCapacity, m_particles.GetArena());
+  resizedParticles.CopyParticles(m_particles, keptCount);
+  m_particles = std::move(resizedParticles);
+
+  m_particleDataForGPUs.resize(pCapacity);
+  if (m_gpuDataFormat == gdf_packed)
+    m_packedGPUData.resize(pCapacity);
+  m_liveParticleCount = keptCount;
+}
+
+void particleEmitter::SortParticlesByDepth(bool pIsCompacted, unsigned pNewCount)
+{
+  if (m_depthSortMode == dsm_none)
+    return;
+
+  particleSpan liveSpans[2];
+  unsigned liveSpanCount = GetLiveSpans(liveSpans);
+
+  if (m_depthSortMode == dsm_full)
+  {
+    m_depthSort.Sort(m_particles, liveSpans, liveSpanCount);
+    return;
+  }
+
+    // the moves are only this update's if the compaction ran
+  unsigned moveCount = pIsCompacted ? m_particles.m_moveCount : 0;
+  m_depthSort.SortIncremental(m_particles, liveSpans, liveSpanCount, m_particles.m_moves, moveCount, pNewCount);
+}
+
+void particleEmitter::WriteGPUData()
+{
+    // packed data stays with the emitter, the ring only holds the full gpu data
+  if (m_gpuDataFormat == gdf_packed)
+  {
+    WritePackedGPUData();
+    return;
+  }
+
+  if (!m_gpuRing)
+  {
+    WriteGPUData(m_particleDataForGPUs.data(), static_cast<unsigned>(m_particleDataForGPUs.size()));
+    return;
+  }
+
+    // straight into the staging buffer, only the active particles are written
+  unsigned count = (m_liveParticleCount < m_gpuRing->GetCapacity()) ? m_liveParticleCount : m_gpuRing->GetCapacity();
+  WriteGPUData(m_gpuRing->BeginWrite(), count);
+  m_gpuRing->EndWrite(count);
+}
+
+void particleEmitter::WriteGPUData(shaderHandler::gPUData* pGPUData, unsigned pCount)
+{
+    // analytic particles are evaluated at the time the others are interpolated to
+  float interpolation = GetRenderInterpolation();
+  if (EvaluateGPUData(GetRenderTimeOffset(), pGPUData, pCount))
+    return;
+
+    // the renderer always gets the active particles in [0, live count), so the spans of a
+    // ring buffer are written one after the other
+  particleSpan liveSpans[2];
+  unsigned liveSpanCount = ClipLiveSpans(liveSpans, pCount);
+  unsigned gpuDataOffset = 0;
+
+  for (unsigned span = 0; span < liveSpanCount; ++span)
+  {
+    unsigned gpuDataShift = gpuDataOffset - liveSpans[span].m_begin;
+
+    ParticleEmitterCommon::RunInChunks(m_jobSystem, liveSpans[span].m_begin, liveSpans[span].m_end, [this, pGPUData, gpuDataShift, interpolation](unsigned pBegin, unsigned pEnd)
+    {
+      ParticleEmitterCommon::WriteGPUData(m_particles, pBegin, pEnd, interpolation, m_emitterData.m_fixedTimeStep, pGPUData + (pBegin + gpuDataShift));
+    });
+
+    gpuDataOffset += liveSpans[span].m_end - liveSpans[span].m_begin;
+  }
+}
+
+void particleEmitter::WritePackedGPUData()
+{
+    // same layout as WriteGPUData, the active particles go to [0, live count)
+  particleSpan liveSpans[2];
+  unsigned liveSpanCount = GetLiveSpans(liveSpans);
+  unsigned packedOffset = 0;
+  float interpolation = GetRenderInterpolation();
+
+  for (unsigned span = 0; span < liveSpanCount; ++span)
+  {
+    unsigned packedShift = packedOffset - liveSpans[span].m_begin;
+
+    ParticleEmitterCommon::RunInChunks(m_jobSystem, liveSpans[span].m_begin, liveSpans[span].m_end, [this, packedShift, interpolation](unsigned pBegin, unsigned pEnd)
+    {
+      ParticleKernels::packedParticle* packed = m_packedGPUData.data() + (pBegin + packedShift);
+
+        // analytic particles have to be evaluated before they can be packed, and
+        // particles between two fixed steps interpolated
+      if (m_isAnalytic)
+        PackAnalyticParticles(pBegin, pEnd, packed);
+      else if (interpolation < 1.0f)
+        PackInterpolatedParticles(pBegin, pEnd, interpolation, packed);
+      else
+        ParticleKernels::PackParticles(m_particles, pBegin, pEnd, m_gpuDataOrigin, packed);
+    });
+
+    packedOffset += liveSpans[span].m_end - liveSpans[span].m_begin;
+  }
+}
+
+void particleEmitter::PackAnalyticParticles(unsigned pBegin, unsigned pEnd, ParticleKernels::packedParticle* pPacked)
+{
+  ParticleKernels::evaluateParameters parameters = { m_emitterData.m_constantAcceleration, m_emitterData.m_initialColor, m_emitterData.m_finalColor, GetRenderTimeOffset() };
+
+    // evaluated into columns a batch at a time, then packed like any other particles
+  float positionX[c_packBatchSize], positionY[c_packBatchSize], rotation[c_packBatchSize], scale[c_packBatchSize];
+  float colorR[c_packBatchSize], colorG[c_packBatchSize], colorB[c_packBatchSize], colorA[c_packBatchSize];
+  ParticleKernels::evaluatedColumns columns = { positionX, positionY, rotation, scale, colorR, colorG, colorB, colorA };
+
+  ParticleKernels::packSource source = { positionX, positionY, nullptr, rotation, scale, colorR, colorG, colorB, colorA,
+                                         m_gpuDataOrigin.x, m_gpuDataOrigin.y, m_gpuDataOrigin.z };
+
+  for (unsigned batchBegin = pBegin; batchBegin < pEnd; batchBegin += c_packBatchSize)
+  {
+    unsigned batchCount = (pEnd - batchBegin < c_packBatchSize) ? pEnd - batchBegin : c_packBatchSize;
+    ParticleKernels::EvaluateParticles(m_particles, batchBegin, batchBegin + batchCount, parameters, columns);
+
+      // z never changes, so it's packed straight from the storage
+    source.m_positionZ = m_particles.m_positionZ + batchBegin;
+    ParticleKernels::PackParticles(source, batchCount, pPacked + (batchBegin - pBegin));
+  }
+}
+
+void particleEmitter::PackInterpolatedParticles(unsigned pBegin, unsigned pEnd, float pInterpolation, ParticleKernels::packedParticle* pPacked)
+{
+    // only the position and rotation are interpolated, the rest is packed straight from
+    // the storage
+  float positionX[c_packBatchSize], positionY[c_packBatchSize], rotation[c_packBatchSize];
+
+  for (unsigned batchBegin = pBegin; batchBegin < pEnd; batchBegin += c_packBatchSize)
+  {
+    unsigned batchCount = (pEnd - batchBegin < c_packBatchSize) ? pEnd - batchBegin : c_packBatchSize;
+
+    for (unsigned batchIndex = 0; batchIndex < batchCount; ++batchIndex)
+      ParticleEmitterCommon::InterpolateParticle(m_particles, batchBegin + batchIndex, pInterpolation, m_emitterData.m_fixedTimeStep, positionX[batchIndex], positionY[batchIndex], rotation[batchIndex]);
+
+    ParticleKernels::packSource source = { positionX, positionY, m_particles.m_positionZ + batchBegin, rotation, m_particles.m_scale + batchBegin,
+                                           m_particles.m_colorR + batchBegin, m_particles.m_colorG + batchBegin, m_particles.m_colorB + batchBegin,
+                                           m_particles.m_colorA + batchBegin, m_gpuDataOrigin.x, m_gpuDataOrigin.y, m_gpuDataOrigin.z };
+    ParticleKernels::PackParticles(source, batchCount, pPacked + (batchBegin - pBegin));
+  }
+}
@@ -8,10 +8,19 @@
 This is the interface for the particle emitter class
 ******************************************************************************************/
 #pragma once
+#include <functional>
 #include <vector>
 
 #include "../Transform.h"
 #include "EmitterData.h"
+#include "ParticleStorage.h"
+#include "ParticleArena.h"
+#include "ParticleRandom.h"
+#include "ParticleGrid.h"
+#include "ParticleDistanceField.h"
+#include "ParticleDepthSort.h"
+#include "ParticleProfiler.h"
+#include "ParticleKernels.h"
 #include "ParticleEmitterBundle.h"
 
 
@@ -21,7 +30,67 @@ class colliderPolygon;
 class circle;
 class polygon;
 class collider;
-class particle;
+class particleEmitter;
+class particleJobSystem;
+class particleEmitterScheduler;
+class particleGPURing;
+
+/*!*************************************************************************************
+\par struct: particleEmitterUpdate
+\brief   An emitter together with the transform it's updated with. Used to update lots
+  of emitters (of one or many bundles) at once.
+
+\par baseClass: true
+***************************************************************************************/
+struct particleEmitterUpdate
+{
+  particleEmitter* m_emitter; //!< emitter to update
+  transform* m_transform;     //!< transform the emitter spawns its particles from
+};
+
+/*!*************************************************************************************
+\par struct: particleCollider
+\brief   A collider together with its transform. Used to check the particles of an
+  emitter against lots of colliders at once. Colliders that never move can be baked
+  into a distance field when the level loads, which is used instead of their faces.
+
+\par baseClass: true
+***************************************************************************************/
+struct particleCollider
+{
+  collider* m_collider;   //!< collider the particles can hit
+  transform* m_transform; //!< transform of the collider
+  const particleDistanceField* m_distanceField; //!< field the collider is baked into (nullptr if it isn't)
+};
+
+  // gpu data of an emitter lives in the same arena as its particles
+typedef std::vector<shaderHandler::gPUData, particleArenaAllocator<shaderHandler::gPUData> > particleGPUDataVector;
+typedef std::vector<ParticleKernels::packedParticle, particleArenaAllocator<ParticleKernels::packedParticle> > particlePackedDataVector;
+
+/*!*************************************************************************************
+\par enum: particleGPUDataFormat
+\brief   Format the renderer gets the particles of an emitter in
+
+\par baseClass: true
+***************************************************************************************/
+enum particleGPUDataFormat
+{
+  gdf_full,  //!< shaderHandler::gPUData (GetGPUData)
+  gdf_packed //!< ParticleKernels::packedParticle, half floats and RGBA8 (GetPackedGPUData)
+};
+
+/*!*************************************************************************************
+\par enum: particleDepthSortMode
+\brief   How the particles of an emitter are sorted for alpha blending
+
+\par baseClass: true
+***************************************************************************************/
+enum particleDepthSortMode
+{
+  dsm_none,       //!< not sorted, drawn in the order of the gpu data
+  dsm_full,       //!< sorted from scratch every update
+  dsm_incremental //!< last update's order fixed up every update (quicker if depths barely change)
+};
 
 /*!*************************************************************************************
 \par class: particleEmitter
@@ -36,86 +105,121 @@ public:
   \brief  constructor for the particle emitter
 
   \param pEmitterData - information given by client to create the particle emiiter
+  \param pArena - arena the particles are allocated from (usually shared by the emitters
+         of a bundle, nullptr for the global arena)
   *************************************************************************************/
-  particleEmitter(const emitterData& pEmitterData);
+  particleEmitter(const emitterData& pEmitterData, particleArena* pArena = nullptr);
   
   /*!***********************************************************************************
-  \brief  Updates the current lifetime of a particle and sets it to active/inactive 
-    accordingly
-  \param particle - particle to update
-  \param dt - time passed since last frame
+  \brief  Updates the whole particle emitter. With a fixed time step
+          (m_fixedTimeStep) the particles are simulated in as many whole steps as fit
+          into the time passed, and rendered between the last two of them.
+  
   \param pTransform - If the updated particle needs to be reset, this is the transform it
          needs to be reset to
   *************************************************************************************/
-  void UpdateParticleActivity(particle& particle, float dt, transform& pTransform);
+  void UpdateParticleEmitter(float dt, transform& pTransform);
 
   /*!***********************************************************************************
-  \brief  Updates the the color of the particle according to initial & final values.
-          Uses linear interpolation
-  
-  \param particle - particle to update
+  \brief  Updates a list of emitters on all the workers of the job system. Every emitter
+          only touches its own data so they can all be updated at the same time. Only
+          returns once all of them are updated, so GetGPUData can be read right after.
+
+  \param pEmitters - emitters to update along with their transforms
+  \param dt - time passed since last frame
+  \param pJobSystem - job system to spread the emitters across
   *************************************************************************************/
-  void UpdateParticleColors(particle& particle);
- 
+  static void UpdateParticleEmitters(std::vector<particleEmitterUpdate>& pEmitters, float dt, particleJobSystem& pJobSystem);
+
   /*!***********************************************************************************
-  \brief  If the particle has been set to inactive, this resets all its values to a "new" one
+  \brief  Works out which stages of the update the particles need from the emitter data
 
-  \param particle - particle to reset
-  \param pTransform - Position to reset the particle to
+  \param pEmitterData - emitter data the particles are spawned from
+  \return ParticleKernels::updateFeature values or'ed together
   *************************************************************************************/
-  void ResetParticle(particle& particle, const transform& pTransform);
+  static unsigned GetUpdateFeatures(const emitterData& pEmitterData);
 
   /*!***********************************************************************************
-  \brief  Updates the physics of the particle being updated
+  \brief  Updates the particle emitter's activity according to the wave times
 
-  \param particle - particle to update
-  \param dt - time passed since last frame
-  \param accumulatedForce - forces accumulated over the past frame that needs to be 
+  \param dt - Time elapsed since last frame
+  *************************************************************************************/
+  void UpdateParticleEmitterWaveTiming(float dt);
+
+  /*!***********************************************************************************
+  \brief  Updates the lifetime, colors, scale and physics of a range of active particles
+          at once, with the update kernel compiled for the stages the emitter needs
+
+  \param accumulatedForce - forces accumulated over the past frame that needs to be
          taken into account.
+  \param pBegin - index of the first particle to update
+  \param pEnd - one past the index of the last particle to update
+  \param dt - time passed since last frame
   *************************************************************************************/
-  void UpdateParticlePhysics(const vector4& accumulatedForce, particle& particle, float dt);
+  void UpdateParticleRange(const vector4& accumulatedForce, unsigned pBegin, unsigned pEnd, float dt);
 
   /*!***********************************************************************************
-  \brief  Updates the whole particle emitter
-  
-  \param pTransform - If the updated particle needs to be reset, this is the transform it
-         needs to be reset to
+  \brief  Sets the job system used to split the update of big emitters into chunks
+
+  \param pJobSystem - job system to use (nullptr to always update on the calling thread)
   *************************************************************************************/
-  void UpdateParticleEmitter(float dt, transform& pTransform);
+  void SetJobSystem(particleJobSystem* pJobSystem);
 
   /*!***********************************************************************************
-  \brief  Updates the particle emitter's activity according to the wave times
+  \brief  Sets the scheduler the emitter is updated by, so restarting the emitter wakes it
+          up (set by the scheduler, the emitter has to be removed from it before it's
+          destroyed)
 
-  \param dt - Time elapsed since last frame
+  \param pScheduler - scheduler updating the emitter (nullptr if it's updated directly)
   *************************************************************************************/
-  void UpdateParticleEmitterWaveTiming(float dt);
+  void SetScheduler(particleEmitterScheduler* pScheduler);
 
   /*!***********************************************************************************
-  \brief  Updates the the scale of the particle according to initial & final values.
-          Uses linear interpolation
+  \brief  Sets the bundle holding the emitter (the profiler adds up the stats of the
+          emitters per bundle)
 
-  \param particle - particle to update
+  \param pParent - bundle holding the emitter
   *************************************************************************************/
-  void UpdateParticleScale(particle& particle);
+  void SetParent(particleEmitterBundle* pParent);
 
+#ifdef PARTICLE_PROFILING
   /*!***********************************************************************************
-  \brief  Updates a single particle (calls all other particle stuff)
+  \brief  Gets the counters and phase times of the last frame the emitter updated in
+          (only with PARTICLE_PROFILING)
 
-  \param particle - particle to update
-  \param dt - time passed since last frame
-  \param accumulatedForce - forces accumulated over the past frame that needs to be
-         taken into account.
-  \param pTransform - If the updated particle needs to be reset, this is the transform it
-  needs to be reset to
+  \return stats of the last frame
+  *************************************************************************************/
+  const particleFrameStats& GetFrameStats() const;
+#endif
+
+  /*!***********************************************************************************
+  \brief  Whether the emitter has nothing left to do until it's restarted (it's stopped
+          and all of its particles died)
+
+  \return if updating the emitter wouldn't change anything
+  *************************************************************************************/
+  bool IsDormant() const;
+
+  /*!***********************************************************************************
+  \brief  Gets the area the particles can reach from where they spawn within their
+          lifetime, along with the box around the live particles (which can be outside
+          of it when the emitter moved or they were pushed by additional forces or
+          collisions). Goes over the live particles, a batch at a time.
+
+  \param pTransform - transform the emitter spawns its particles from
+  \param pBounds - filled with min x, min y, max x and max y
   *************************************************************************************/
-  void UpdateParticle(const vector4& accumulatedForce, particle& particle, float dt, transform& pTransform);
+  void GetBounds(const transform& pTransform, float pBounds[4]) const;
 
   /*!***********************************************************************************
-  \brief  Creates a brand new particle if enough havent been created yet
+  \brief  Picks the level of detail for the distance from the camera (m_lodTiers). The
+          spawn rate and particle cap fade into a tier over m_lodBlendDistance, so
+          particles don't pop in or out, while the update interval and collisions switch
+          as soon as the tier starts.
 
-  \param pPosition - position to create particle at
+  \param pDistance - distance from the camera to the emitter
   *************************************************************************************/
-  void CreateParticle(const transform& pTransform);
+  void SetCameraDistance(float pDistance);
 
   /*!***********************************************************************************
   \brief  Adds force to the system of particles that should be taken into account
@@ -129,42 +233,103 @@ public:
 
   \return vector m_particleDataForGPUs
   *************************************************************************************/
-  std::vector<shaderHandler::gPUData>& GetGPUData();
+  particleGPUDataVector& GetGPUData();
 
   /*!***********************************************************************************
-  \brief  Returns reference to the vector of particles for each particle
+  \brief  Returns the gpu data of the active particles only, which are always at the
+          front. Empty while the emitter writes into a gpu ring or packs its gpu data
+          (GetPackedGPUData) instead.
 
-  \return vector m_particles
+  \param pCount - set to the number of particles in the gpu data
+  \return first particle of the gpu data
   *************************************************************************************/
-  std::vector<particle>& GetParticles();
+  const shaderHandler::gPUData* GetLiveGPUData(unsigned& pCount) const;
 
   /*!***********************************************************************************
-  \brief  Returns reference of the data the emitter is based on
+  \brief  Makes the update write the gpu data of the active particles straight into a
+          frame of the ring (a staging buffer the renderer uploads from) instead of into
+          the vector from GetGPUData. Particles that don't fit in a frame aren't drawn.
+          Packed gpu data (gdf_packed) never goes through the ring, it's always read from
+          GetPackedGPUData, so the ring has nothing new to upload while the emitter packs.
 
-  \return reference to m_emitterData
+  \param pRing - ring to write into (nullptr to go back to the vector)
   *************************************************************************************/
-  emitterData& GetEmitterData();
+  void SetGPURing(particleGPURing* pRing);
 
   /*!***********************************************************************************
-  \brief  If the particles per second changes, the time between particles spawned is
-          changed by this function accordingly.
+  \brief  Sets the format the update writes the gpu data in. The packed format is about
+          a quarter of the size, but the positions are relative to the emitter and lose
+          precision further away from it. Packed data isn't written into a gpu ring.
 
+  \param pFormat - format to write the gpu data in
   *************************************************************************************/
-  void ResetTimeBetweenParticles();
+  void SetGPUDataFormat(particleGPUDataFormat pFormat);
 
   /*!***********************************************************************************
-  \brief  used to sort the current active and inactive particles in the vector
+  \brief  Gets the format the update writes the gpu data in
 
-  \param pParticle - particle to swap
+  \return format of the gpu data
   *************************************************************************************/
-  void SwapWithLastActiveParticle(particle& pParticle);
-  
+  particleGPUDataFormat GetGPUDataFormat() const;
+
   /*!***********************************************************************************
-  \brief  used to sort the current active and inactive particles in the vector
+  \brief  Returns the packed gpu data of the active particles (empty unless the format
+          is gdf_packed)
 
-  \param pParticle - particle to swap
+  \param pCount - set to the number of packed particles
+  \param pOrigin - set to the position the packed positions are relative to
+  \return first packed particle
   *************************************************************************************/
-  void SwapWithFirstInactiveParticle(particle& pParticle);
+  const ParticleKernels::packedParticle* GetPackedGPUData(unsigned& pCount, vector4& pOrigin) const;
+
+  /*!***********************************************************************************
+  \brief  Sets how the update sorts the particles by depth for alpha blending. Additive
+          or opaque particles don't need it, so it's off by default.
+
+  \param pMode - how to sort the particles
+  *************************************************************************************/
+  void SetDepthSort(particleDepthSortMode pMode);
+
+  /*!***********************************************************************************
+  \brief  Returns the order to draw the particles in, back to front (empty unless the
+          particles are sorted). The gpu data itself isn't reordered, the order indexes
+          into it (GetGPUData, GetPackedGPUData or the frame written to the gpu ring,
+          where indices past the ring's capacity weren't written).
+
+  \param pCount - set to the number of particles in the order
+  \return index into the gpu data of every particle, back to front
+  *************************************************************************************/
+  const unsigned* GetDrawOrder(unsigned& pCount) const;
+
+  /*!***********************************************************************************
+  \brief  Returns reference to the storage of all the particles. Single particles can be
+          accessed through it with operator[]
+
+  \return storage m_particles
+  *************************************************************************************/
+  particleStorage& GetParticles();
+
+  /*!***********************************************************************************
+  \brief  Returns reference to the random stream the particles are spawned with. Seeding
+          it makes the emitter spawn the exact same particles again (for replays).
+
+  \return random stream m_random
+  *************************************************************************************/
+  particleRandom& GetRandom();
+
+  /*!***********************************************************************************
+  \brief  Returns reference of the data the emitter is based on
+
+  \return reference to m_emitterData
+  *************************************************************************************/
+  emitterData& GetEmitterData();
+
+  /*!***********************************************************************************
+  \brief  If the particles per second changes, the time between particles spawned is
+          changed by this function accordingly.
+
+  *************************************************************************************/
+  void ResetTimeBetweenParticles();
 
   /*!***********************************************************************************
   \brief  returns the renderer used for graphics stuff
@@ -180,6 +345,71 @@ public:
   *************************************************************************************/
   unsigned GetLiveParticleCount() const;
 
+  /*!***********************************************************************************
+  \brief  Gets the ranges of the particle storage holding the active particles. Usually
+          that's just [0, live count), but an emitter running as a ring buffer can wrap
+          around the end of the storage.
+
+  \param pSpans - filled with the ranges of active particles
+  \return number of ranges filled (0, 1 or 2)
+  *************************************************************************************/
+  unsigned GetLiveSpans(particleSpan pSpans[2]) const;
+
+  /*!***********************************************************************************
+  \brief  Same as GetLiveSpans, but the ranges only hold the oldest pCount particles
+
+  \param pSpans - filled with the ranges of active particles
+  \param pCount - most particles the ranges hold
+  \return number of ranges filled (0, 1 or 2)
+  *************************************************************************************/
+  unsigned ClipLiveSpans(particleSpan pSpans[2], unsigned pCount) const;
+
+  /*!***********************************************************************************
+  \brief  Whether the emitter stores its particles as a ring buffer. That's the case when
+          every particle lives for the same time (m_randomParticleLifetimeRange is 0),
+          since particles then die in the order they were born.
+
+  \return if the emitter is a ring buffer
+  *************************************************************************************/
+  bool IsRingBuffer() const;
+
+  /*!***********************************************************************************
+  \brief  Whether the particles are evaluated in closed form instead of being integrated
+          every frame. Only emitters that ask for it (m_useAnalyticMotion) and whose
+          particles don't collide with colliders or each other (m_isInteractable and
+          m_interactsWithSelf are false) are, since nothing but time changes them then.
+          The storage keeps the state every particle spawned with (position, velocity
+          and rotation) and only the lifetimes are updated, so the storage's position,
+          velocity, rotation, scale and color (and GetParticles) aren't the current ones.
+          The exact path also differs a little from the integrated one (by a * t * dt / 4
+          for an acceleration a).
+
+  \return if the particles are evaluated in closed form
+  *************************************************************************************/
+  bool IsAnalytic() const;
+
+  /*!***********************************************************************************
+  \brief  Writes the gpu data of the active particles as they will be pTimeOffset seconds
+          after the last update (before it if negative), without changing them. Only
+          works for analytic emitters. Particles that spawn or die in between aren't
+          taken into account, and none are evaluated before they spawned.
+
+  \param pTimeOffset - time from the last update to evaluate the particles at
+  \return false if the emitter isn't analytic (the gpu data is left alone then)
+  *************************************************************************************/
+  bool EvaluateGPUData(float pTimeOffset);
+
+  /*!***********************************************************************************
+  \brief  Same as EvaluateGPUData, but writes into any memory with room for the active
+          particles (like a frame of a gpu ring)
+
+  \param pTimeOffset - time from the last update to evaluate the particles at
+  \param pGPUData - where the gpu data of the first active particle goes
+  \param pCount - most particles to write
+  \return false if the emitter isn't analytic (nothing is written then)
+  *************************************************************************************/
+  bool EvaluateGPUData(float pTimeOffset, shaderHandler::gPUData* pGPUData, unsigned pCount);
+
   /*!***********************************************************************************
   \brief  Resets the lifetime of the particle emitter
   *************************************************************************************/
@@ -197,33 +427,315 @@ public:
   \param interactableCollider - collider to check interactions with
   *************************************************************************************/
   void CheckParticleCollisions(transform& colliderTransform, collider& interactableCollider);
+
+  /*!***********************************************************************************
+  \brief  Checks the particles against a list of colliders (usually the ones a broadphase
+          found near the emitter) in a single pass over the particles. Every batch of
+          particles is checked against all colliders before moving on to the next one,
+          and colliders that aren't near a batch are skipped. Polygons are resolved
+          before baked colliders and circles, all in the order of the list.
+
+  \param pColliders - colliders to check interactions with
+  \param pColliderCount - number of colliders
+  *************************************************************************************/
+  void CheckParticleCollisions(const particleCollider* pColliders, unsigned pColliderCount);
   
   
 private:
   /*!***********************************************************************************
-  \brief  handles particle collisions with convex polygon colliders
+  \brief  a convex polygon collider moved into world space for a collision pass
+  *************************************************************************************/
+  struct polygonCollider
+  {
+    unsigned m_firstFace;                     //!< first vertex and plane of the polygon in the collider vectors
+    ParticleKernels::polygonPlanes m_planes;  //!< half planes and bounding box of the polygon
+    vector4 m_velocity;                       //!< velocity of the collider's rigid body
+  };
+
+  /*!***********************************************************************************
+  \brief  a circle collider moved into world space for a collision pass
+  *************************************************************************************/
+  struct circleCollider
+  {
+    ParticleKernels::circleShape m_circle; //!< circle in world space
+    vector4 m_velocity;                    //!< velocity of the collider's rigid body
+  };
+
+  /*!***********************************************************************************
+  \brief  a static collider baked into a distance field
+  *************************************************************************************/
+  struct fieldCollider
+  {
+    const particleDistanceField* m_field; //!< field the collider is baked into
+    float m_bounds[4];                    //!< area covered by the field (min x, min y, max x, max y)
+    vector4 m_velocity;                   //!< velocity of the collider's rigid body
+  };
+
+  /*!***********************************************************************************
+  \brief  handles particle collisions with a collider baked into a distance field. Costs
+          two lookups per particle inside no matter how many faces the collider has (the
+          normal is the gradient of the field instead of the normal of a face)
+
+  \param pField - collider the particles are inside of
+  \param pParticles - indices of the particles inside the collider
+  \param pCount - number of particles inside the collider
+  *************************************************************************************/
+  void ResolveFieldCollisions(const fieldCollider& pField, const unsigned* pParticles, unsigned pCount);
+
+  /*!***********************************************************************************
+  \brief  Moves a circle collider into world space and adds it to the colliders of the
+          current collision pass
 
   \param colliderTransform - transform of collider to check with interactions
   \param interactableCollider - collider to check interactions with
   *************************************************************************************/
-  void ParticlePolygonCollisions(transform& colliderTransform, colliderPolygon& interactableCollider);
+  void PrepareCircleCollider(transform& colliderTransform, colliderCircle& interactableCollider);
+
+  /*!***********************************************************************************
+  \brief  handles particle collisions with circle colliders, the same way the polygons
+          are handled (the normal points from the center to the particle)
+
+  \param pCircle - collider the particles are inside of
+  \param pParticles - indices of the particles inside the collider
+  \param pCount - number of particles inside the collider
+  *************************************************************************************/
+  void ResolveCircleCollisions(const circleCollider& pCircle, const unsigned* pParticles, unsigned pCount);
+
+  /*!***********************************************************************************
+  \brief  Moves the faces of a convex polygon collider into world space and adds it to
+          the colliders of the current collision pass
+
+  \param colliderTransform - transform of collider to check with interactions
+  \param interactableCollider - collider to check interactions with
+  *************************************************************************************/
+  void PreparePolygonCollider(transform& colliderTransform, colliderPolygon& interactableCollider);
+
+  /*!***********************************************************************************
+  \brief  Checks the active particles against the colliders of the last collision pass
+          again (after a fixed step moved them)
+  *************************************************************************************/
+  void ResolvePreparedCollisions();
+
+  /*!***********************************************************************************
+  \brief  handles particle collisions with convex polygon colliders
+
+  \param pPolygon - collider the particles are inside of
+  \param pParticles - indices of the particles inside the collider
+  \param pCount - number of particles inside the collider
+  *************************************************************************************/
+  void ResolvePolygonCollisions(const polygonCollider& pPolygon, const unsigned* pParticles, unsigned pCount);
+
+  /*!***********************************************************************************
+  \brief  Bounces a particle that hit a collider off of it. The particle is pushed out
+          along the normal a little harder than a plain reflection, and slowed down by
+          the emitter's restitution (kept within [0, 1])
+
+  \param pIndex - index of the particle
+  \param pNormal - unit normal of the collider where the particle entered
+  \param pColliderVelocity - velocity of the collider's rigid body
+  \param pRestitutionOffset - random offset added to the emitter's restitution
+  *************************************************************************************/
+  void ReflectParticle(unsigned pIndex, const vector4& pNormal, const vector4& pColliderVelocity, float pRestitutionOffset);
+
+  /*!***********************************************************************************
+  \brief  Moves the particles on by one step: integrates them, removes the dead ones and
+          spawns the ones due
+
+  \param pTotalForce - forces accumulated over the past frame
+  \param dt - length of the step
+  \param pTransform - transform to spawn the particles at
+  *************************************************************************************/
+  void StepParticles(const vector4& pTotalForce, float dt, transform& pTransform);
+
+  /*!***********************************************************************************
+  \brief  Adds the time passed to the time left over from the last fixed step and takes
+          as many whole steps out of it as fit (but no more than m_maxSubsteps)
+
+  \param dt - time passed since the last update
+  \return number of fixed steps to take
+  *************************************************************************************/
+  unsigned TakeFixedSteps(float dt);
+
+  /*!***********************************************************************************
+  \brief  Gets how far the time left over is into the next fixed step
+
+  \return 0 to render the state before the last step, 1 to render the last one (always
+          1 without a fixed step)
+  *************************************************************************************/
+  float GetRenderInterpolation() const;
+
+  /*!***********************************************************************************
+  \brief  Gets the time from the last update analytic particles are rendered at, so
+          they're in step with interpolated ones
+
+  \return time offset (0 or negative)
+  *************************************************************************************/
+  float GetRenderTimeOffset() const;
+
+  /*!***********************************************************************************
+  \brief  Works out how many particles are due from the time since the last spawn and
+          spawns all of them right after the last active particle, in batches
+
+  \param pTransform - transform to spawn the particles at
+  *************************************************************************************/
+  void SpawnParticles(const transform& pTransform);
+
+  /*!***********************************************************************************
+  \brief  Kills the oldest particles of a ring buffer that lived their whole life
+  *************************************************************************************/
+  void KillOldestParticles();
+
+  /*!***********************************************************************************
+  \brief  Turns a ring buffer back into plain storage with the active particles at the
+          front (when particles stop dying in order)
+  *************************************************************************************/
+  void StopRingBuffer();
+
+  /*!***********************************************************************************
+  \brief  Switches to closed form evaluation, works out the state every active particle
+          would have spawned with from its current state
+  *************************************************************************************/
+  void StartAnalyticMode();
+
+  /*!***********************************************************************************
+  \brief  Switches back to integrating the particles every frame, writes the current
+          state of every active particle into the storage
+  *************************************************************************************/
+  void StopAnalyticMode();
+
+  /*!***********************************************************************************
+  \brief  Whether the particles of the emitter can be evaluated in closed form
+
+  \return true if the emitter data asks for it and nothing but time changes the
+          particles
+  *************************************************************************************/
+  bool CanBeAnalytic() const;
+
+  /*!***********************************************************************************
+  \brief  Pushes apart the active particles that overlap (for emitters with
+          m_interactsWithSelf). The particles are sorted into a spatial hash grid first,
+          so every particle only checks the ones close by. The overlap is taken out of
+          the positions, so it doesn't speed the particles up. Only the bounce of
+          particles moving towards each other is added to their force, so it's applied
+          by the next physics update.
+  *************************************************************************************/
+  void ResolveSelfInteractions();
+
+  /*!***********************************************************************************
+  \brief  Changes the number of particles the emitter can hold (when
+          m_numberofParticles was changed). Particles that don't fit anymore are dropped.
+
+  \param pCapacity - new number of particles
+  *************************************************************************************/
+  void ResizeParticlePool(unsigned pCapacity);
+
+  /*!***********************************************************************************
+  \brief  sorts the active particles by depth for alpha blending (if they're sorted)
+
+  \param pIsCompacted - if the compaction moved particles this update
+  \param pNewCount - number of particles spawned this update
+  *************************************************************************************/
+  void SortParticlesByDepth(bool pIsCompacted, unsigned pNewCount);
+
+  /*!***********************************************************************************
+  \brief  copies the final transform and color of every active particle from the
+          particle storage into the gpu data (or the gpu ring if there is one)
+  *************************************************************************************/
+  void WriteGPUData();
+
+  /*!***********************************************************************************
+  \brief  copies the final transform and color of the active particles from the particle
+          storage into any memory with room for them
+
+  \param pGPUData - where the gpu data of the first active particle goes
+  \param pCount - most particles to write
+  *************************************************************************************/
+  void WriteGPUData(shaderHandler::gPUData* pGPUData, unsigned pCount);
+
+  /*!***********************************************************************************
+  \brief  packs the active particles into the packed gpu data
+  *************************************************************************************/
+  void WritePackedGPUData();
+
+  /*!***********************************************************************************
+  \brief  packs a range of analytic particles, evaluated at the age they're rendered at
+
+  \param pBegin - first particle to pack
+  \param pEnd - one past the last particle to pack
+  \param pPacked - filled with the packed particles (pEnd - pBegin of them)
+  *************************************************************************************/
+  void PackAnalyticParticles(unsigned pBegin, unsigned pEnd, ParticleKernels::packedParticle* pPacked);
+
+  /*!***********************************************************************************
+  \brief  packs a range of particles interpolated between the last two fixed steps
+
+  \param pBegin - first particle to pack
+  \param pEnd - one past the last particle to pack
+  \param pInterpolation - how far to go from the state before the last step
+  \param pPacked - filled with the packed particles (pEnd - pBegin of them)
+  *************************************************************************************/
+  void PackInterpolatedParticles(unsigned pBegin, unsigned pEnd, float pInterpolation, ParticleKernels::packedParticle* pPacked);
+
+  typedef std::vector<vector4, particleArenaAllocator<vector4> > vertexVector;
+  typedef std::vector<float, particleArenaAllocator<float> > floatVector;
+  typedef std::vector<polygonCollider, particleArenaAllocator<polygonCollider> > polygonColliderVector;
+  typedef std::vector<circleCollider, particleArenaAllocator<circleCollider> > circleColliderVector;
+  typedef std::vector<fieldCollider, particleArenaAllocator<fieldCollider> > fieldColliderVector;
 
   vector4 m_additionalForce; //!< additional forces added to the system (cleared every frame)
   float m_currentLifeTime;   //!< emitter's current lifetime
-  float m_isEmitterActive;   //!< if emitter is currently active or not
+  bool m_isEmitterActive;    //!< if emitter is currently active or not
 
 	// gpu data holds the particle's final transform and color that need's to be rendered by the shader
-  std::vector<shaderHandler::gPUData> m_particleDataForGPUs; //!< vector of all the gpu data for each particle
-  std::vector<particle> m_particles; //!< vector of particles in the emitter
+  particleGPUDataVector m_particleDataForGPUs; //!< vector of all the gpu data for each particle
+  particleGPURing* m_gpuRing; //!< staging buffer the gpu data is written to instead (can be null)
+  particleStorage m_particles; //!< all the particle data in the emitter (structure of arrays)
+  particleGrid m_selfInteractionGrid; //!< grid the particles are sorted into when they interact with each other
+  vertexVector m_colliderVertices;    //!< vertices of the colliders being checked, in world space
+  floatVector m_colliderPlanes;       //!< half planes of the faces of the colliders being checked (normal x, normal y, d)
+  polygonColliderVector m_polygonColliders; //!< polygon colliders being checked
+  circleColliderVector m_circleColliders;   //!< circle colliders being checked
+  fieldColliderVector m_fieldColliders;     //!< baked colliders being checked
+  particleGPUDataFormat m_gpuDataFormat;    //!< format the gpu data is written in
+  particlePackedDataVector m_packedGPUData; //!< packed gpu data of every particle (empty unless packed)
+  vector4 m_gpuDataOrigin;                  //!< position the packed positions are relative to
+  particleDepthSortMode m_depthSortMode;    //!< how the particles are sorted for alpha blending
+  particleDepthSort m_depthSort;            //!< order to draw the particles in
+
+  bool m_isRingBuffer;  //!< if the particles are stored as a ring buffer (oldest first)
+  unsigned m_ringStart; //!< index of the oldest active particle when stored as a ring buffer
+  bool m_isAnalytic;    //!< if the particles are evaluated in closed form instead of integrated
 
   unsigned m_liveParticleCount;  //!< number of particles currently active
   emitterData m_emitterData;     //!< holds all the data for this particle emitter given by client
 
+  unsigned m_updateFeatures;                 //!< stages of the update the particles need
+  ParticleKernels::updateKernel m_updateKernel; //!< update kernel compiled for m_updateFeatures
+
   float m_timeBetweenParticles; //!< time between each particle should be spawed
   float m_timesSinceLastParticleSpawned; //!< time sice the last particle spawned
 
   float m_currentWaveTime; //!< used for making a wave / burst of particles
   bool m_isEmitterPaused;  //!< boolean to help with determining if an emitter is in a wave of spawning particles or not.
 
+  particleRandom m_random; //!< random stream of this emitter only (safe to use while other emitters update)
+
+  float m_lodSpawnRateScale;    //!< scale for the spawn rate from the level of detail
+  float m_lodParticleCapScale;  //!< scale for the number of particles from the level of detail
+  unsigned m_lodUpdateInterval; //!< number of frames between updates from the level of detail
+  bool m_lodCollides;           //!< if the particles check colliders at the level of detail
+  unsigned m_lodSkippedFrames;  //!< frames since the last update
+  float m_lodSkippedTime;       //!< time since the last update
+  float m_stepAccumulator;      //!< time left over from the last fixed step
+
   particleEmitterBundle *m_parent; //!< parent holding all the particle emitters.
+  particleJobSystem *m_jobSystem;  //!< job system for updating chunks of particles (can be null)
+  particleEmitterScheduler *m_scheduler; //!< scheduler updating the emitter (can be null)
+
+#ifdef PARTICLE_PROFILING
+  particleEmitterProfile m_profile; //!< counters and phase times of the emitter
+#endif
+
+  static const unsigned c_collisionBatchSize = 256; //!< particles checked against a collider at once
+  static const unsigned c_packBatchSize = 256;      //!< particles evaluated or interpolated at once before they're packed (or written to the gpu data)
 };
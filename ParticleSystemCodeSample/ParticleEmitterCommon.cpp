@@ -0,0 +1,188 @@
+/*!****************************************************************************************
+\file       ParticleEmitterCommon.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the parts particleEmitter and particleInstancedEmitter
+share.
+******************************************************************************************/
+
+#include "ParticleEmitterCommon.h"
+#include "ParticleJobSystem.h"
+#include "ParticleRandom.h"
+#include <cmath>
+
+namespace ParticleEmitterCommon
+{
+  void RunInChunks(particleJobSystem* pJobSystem, unsigned pBegin, unsigned pEnd, const std::function<void(unsigned, unsigned)>& pWork)
+  {
+    unsigned chunkCount = (pEnd - pBegin + c_particlesPerChunk - 1) / c_particlesPerChunk;
+
+    if (!pJobSystem || chunkCount < 2)
+    {
+      pWork(pBegin, pEnd);
+      return;
+    }
+
+    pJobSystem->ParallelFor(chunkCount, [pBegin, pEnd, &pWork](unsigned pChunk)
+    {
+      unsigned begin = pBegin + pChunk * c_particlesPerChunk;
+      unsigned end = (begin + c_particlesPerChunk < pEnd) ? begin + c_particlesPerChunk : pEnd;
+      pWork(begin, end);
+    });
+  }
+
+  unsigned TakeDueParticles(float& pTimeSinceLastSpawn, float pTimeBetweenParticles)
+  {
+      // every particle due is spawned at once, no matter how much time passed
+    unsigned dueCount = static_cast<unsigned>(pTimeSinceLastSpawn / pTimeBetweenParticles);
+    pTimeSinceLastSpawn -= dueCount * pTimeBetweenParticles;
+    return dueCount;
+  }
+
+  void SpawnParticleBatch(particleStorage& pParticles, const particleSpan pSpans[2], const emitterData& pEmitterData, particleRandom& pRandom, const transform& pTransform)
+  {
+    unsigned count = (pSpans[0].m_end - pSpans[0].m_begin) + (pSpans[1].m_end - pSpans[1].m_begin);
+
+      // all the random values of the batch are drawn at once, one attribute at a time
+    float randomPositionX[c_spawnBatchSize] = {};
+    float randomPositionY[c_spawnBatchSize] = {};
+    float randomPositionZ[c_spawnBatchSize] = {};
+    float randomAngle[c_spawnBatchSize] = {};
+    float randomInitialScale[c_spawnBatchSize];
+    float randomFinalScale[c_spawnBatchSize];
+    float randomLifetime[c_spawnBatchSize] = {};
+
+    if (pEmitterData.m_randomPositionRange.x)
+      pRandom.FillRange(randomPositionX, count, -pEmitterData.m_randomPositionRange.x, pEmitterData.m_randomPositionRange.x);
+    if (pEmitterData.m_randomPositionRange.y)
+      pRandom.FillRange(randomPositionY, count, -pEmitterData.m_randomPositionRange.y, pEmitterData.m_randomPositionRange.y);
+    if (pEmitterData.m_randomPositionRange.z)
+      pRandom.FillRange(randomPositionZ, count, -pEmitterData.m_randomPositionRange.z, pEmitterData.m_randomPositionRange.z);
+    if (pEmitterData.m_randomAngleRange)
+      pRandom.FillRange(randomAngle, count, -pEmitterData.m_randomAngleRange, pEmitterData.m_randomAngleRange);
+
+    pRandom.FillRange(randomInitialScale, count, -pEmitterData.m_randomScaleFactor, pEmitterData.m_randomScaleFactor);
+    pRandom.FillRange(randomFinalScale, count, -pEmitterData.m_randomScaleFactor, pEmitterData.m_randomScaleFactor);
+
+    if (pEmitterData.m_randomParticleLifetimeRange)
+      pRandom.FillRange(randomLifetime, count, 0.0f, pEmitterData.m_randomParticleLifetimeRange);
+
+    vector4 spawnPosition = pTransform.pos() + pEmitterData.m_offset;
+    float spawnRotation = pTransform.Rot();
+    const vector4& color = pEmitterData.m_initialColor;
+
+    unsigned batchIndex = 0;
+    for (unsigned span = 0; span < 2; ++span)
+    {
+      for (unsigned i = pSpans[span].m_begin; i < pSpans[span].m_end; ++i, ++batchIndex)
+      {
+        pParticles.m_positionX[i] = pParticles.m_oldPositionX[i] = randomPositionX[batchIndex] + spawnPosition.x;
+        pParticles.m_positionY[i] = pParticles.m_oldPositionY[i] = randomPositionY[batchIndex] + spawnPosition.y;
+        pParticles.m_positionZ[i] = randomPositionZ[batchIndex] + spawnPosition.z;
+
+        pParticles.m_rotation[i] = spawnRotation;
+        pParticles.m_angularVelocity[i] = pEmitterData.m_rotationalVelocity;
+
+        pParticles.m_colorR[i] = color.x;
+        pParticles.m_colorG[i] = color.y;
+        pParticles.m_colorB[i] = color.z;
+        pParticles.m_colorA[i] = color.w;
+
+        pParticles.m_randomScale[i * 2] = pEmitterData.m_initialScale + randomInitialScale[batchIndex];
+        pParticles.m_randomScale[i * 2 + 1] = pEmitterData.m_finalScale + randomFinalScale[batchIndex];
+        pParticles.m_scale[i] = pParticles.m_randomScale[i * 2];
+
+        pParticles.m_currentLifetime[i] = 0.0f;
+        pParticles.m_totalLifetime[i] = pEmitterData.m_totalParticleLifetime + randomLifetime[batchIndex];
+
+        float angle = pEmitterData.m_initialAngle + randomAngle[batchIndex];
+        pParticles.m_velocityX[i] = cosf(angle) * pEmitterData.m_initialVelocity;
+        pParticles.m_velocityY[i] = sinf(angle) * pEmitterData.m_initialVelocity;
+
+        pParticles.m_isActive[i] = true;
+      }
+    }
+  }
+
+  void InterpolateParticle(const particleStorage& pParticles, unsigned pIndex, float pInterpolation, float pStep, float& pX, float& pY, float& pRotation)
+  {
+    pX = pParticles.m_positionX[pIndex];
+    pY = pParticles.m_positionY[pIndex];
+    pRotation = pParticles.m_rotation[pIndex];
+
+    if (pInterpolation >= 1.0f)
+      return;
+
+      // the old position is the one before the last step
+    pX = pParticles.m_oldPositionX[pIndex] + (pX - pParticles.m_oldPositionX[pIndex]) * pInterpolation;
+    pY = pParticles.m_oldPositionY[pIndex] + (pY - pParticles.m_oldPositionY[pIndex]) * pInterpolation;
+
+      // particles facing their direction of movement keep facing it
+    if (pParticles.m_angularVelocity[pIndex])
+      pRotation -= pParticles.m_angularVelocity[pIndex] * (pStep * (1.0f - pInterpolation));
+  }
+
+  void WriteGPUData(const particleStorage& pParticles, unsigned pBegin, unsigned pEnd, float pInterpolation, float pStep, shaderHandler::gPUData* pGPUData)
+  {
+    for (unsigned i = pBegin; i < pEnd; ++i)
+    {
+      float x, y, rotation;
+      InterpolateParticle(pParticles, i, pInterpolation, pStep, x, y, rotation);
+
+      shaderHandler::gPUData& gpuData = pGPUData[i - pBegin];
+      gpuData.m_particleTransform.pos(vector4(x, y, pParticles.m_positionZ[i]));
+      gpuData.m_particleTransform.Rot(rotation);
+      gpuData.m_particleTransform.Scl(pParticles.m_scale[i]);
+
+      gpuData.m_particleColor = vector4(pParticles.m_colorR[i], pParticles.m_colorG[i], pParticles.m_colorB[i], pParticles.m_colorA[i]);
+    }
+  }
+
+  void UpdateEmitterLifetime(const emitterData& pEmitterData, float dt, float& pLifeTime, bool& pIsActive)
+  {
+    pLifeTime += dt; // increment the lifetime of the entire particle emitter
+
+    if (pLifeTime > pEmitterData.m_totalLifeTime)
+    {
+        // time to kill a particle emitter
+      pLifeTime = 0;
+
+        // if total lifetime is 0, it means that it is immortal
+      if (pEmitterData.m_totalLifeTime)
+        pIsActive = false;
+    }
+  }
+
+  void UpdateWaveTiming(const emitterData& pEmitterData, float dt, bool pIsActive, float& pWaveTime, bool& pIsPaused)
+  {
+      // nothing to update if emitter is inactive
+    if (!pIsActive)
+      return;
+
+      // updating the particle emitter activity according to the waves data
+    pWaveTime += dt;
+
+      // if particle emitter is currently unpaused, update it with the wave on time
+    if (!pIsPaused)
+    {
+      if (pWaveTime >= pEmitterData.m_waveOnTime)
+      {
+          // wave duration is complete, pausing the emitter
+        pIsPaused = true;
+        pWaveTime = 0;
+      }
+    }
+    else // else update it with the wave off time
+    {
+      if (pWaveTime >= pEmitterData.m_waveOffTime)
+      {
+          // pause in between waves are complete, unpausing the emitter
+        pIsPaused = false;
+        pWaveTime = 0;
+      }
+    }
+  }
+}
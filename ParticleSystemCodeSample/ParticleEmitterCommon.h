@@ -0,0 +1,115 @@
+/*!****************************************************************************************
+\file       ParticleEmitterCommon.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the parts of an emitter particleEmitter and
+particleInstancedEmitter share: running work over chunks of particles, spawning a batch of
+particles, writing their gpu data, and the emitter's lifetime and waves.
+******************************************************************************************/
+#pragma once
+#include <functional>
+
+#include "../Transform.h"
+#include "EmitterData.h"
+#include "ParticleStorage.h"
+
+// forward declarations
+class particleJobSystem;
+class particleRandom;
+
+namespace ParticleEmitterCommon
+{
+  const unsigned c_particlesPerChunk = 4096; //!< particles updated by a single job
+  const unsigned c_spawnBatchSize = 256;     //!< particles spawned by a single batch
+
+  /*!***********************************************************************************
+  \brief  Runs pWork over [pBegin, pEnd) split into chunks of c_particlesPerChunk. The
+          chunks are spread across the job system if there's more than one.
+
+  \param pJobSystem - job system to spread the chunks across (nullptr to run them all
+         on the calling thread)
+  \param pBegin - first particle to run the work over
+  \param pEnd - one past the last particle to run the work over
+  \param pWork - work to do for a range of particles [begin, end)
+  *************************************************************************************/
+  void RunInChunks(particleJobSystem* pJobSystem, unsigned pBegin, unsigned pEnd, const std::function<void(unsigned, unsigned)>& pWork);
+
+  /*!***********************************************************************************
+  \brief  Works out how many particles are due from the time since the last spawn, and
+          keeps the time left over for the next one
+
+  \param pTimeSinceLastSpawn - time since the last particle spawned (the due particles'
+         time is taken off)
+  \param pTimeBetweenParticles - time between two particles
+  \return number of particles due
+  *************************************************************************************/
+  unsigned TakeDueParticles(float& pTimeSinceLastSpawn, float pTimeBetweenParticles);
+
+  /*!***********************************************************************************
+  \brief  Spawns a batch of particles at once. The random values of the batch are drawn
+          in one go and every attribute is written for the whole batch.
+
+  \param pParticles - storage to spawn the particles in (they're set active)
+  \param pSpans - slots to spawn the particles in, the second span is only used when the
+         first one runs into the end of a ring buffer (at most c_spawnBatchSize slots in
+         total)
+  \param pEmitterData - emitter data the particles spawn with
+  \param pRandom - random stream the random values are drawn from
+  \param pTransform - transform to spawn the particles at
+  *************************************************************************************/
+  void SpawnParticleBatch(particleStorage& pParticles, const particleSpan pSpans[2], const emitterData& pEmitterData, particleRandom& pRandom, const transform& pTransform);
+
+  /*!***********************************************************************************
+  \brief  Gets a particle's position and rotation between its state before the last step
+          and the last one
+
+  \param pParticles - storage holding the particle
+  \param pIndex - index of the particle
+  \param pInterpolation - how far to go from the state before the last step (1 for the
+         last state)
+  \param pStep - length of the last step
+  \param pX - filled with the x position
+  \param pY - filled with the y position
+  \param pRotation - filled with the rotation
+  *************************************************************************************/
+  void InterpolateParticle(const particleStorage& pParticles, unsigned pIndex, float pInterpolation, float pStep, float& pX, float& pY, float& pRotation);
+
+  /*!***********************************************************************************
+  \brief  copies the final transform and color of a range of particles into gpu data
+
+  \param pParticles - storage holding the particles
+  \param pBegin - first particle to write
+  \param pEnd - one past the last particle to write
+  \param pInterpolation - how far the particles are rendered between their last two
+         steps (1 for the last state)
+  \param pStep - length of the last step
+  \param pGPUData - where the gpu data of the first particle goes
+  *************************************************************************************/
+  void WriteGPUData(const particleStorage& pParticles, unsigned pBegin, unsigned pEnd, float pInterpolation, float pStep, shaderHandler::gPUData* pGPUData);
+
+  /*!***********************************************************************************
+  \brief  Adds to the lifetime of an emitter, it stops spawning once the lifetime is over
+          (a total lifetime of 0 means it's immortal)
+
+  \param pEmitterData - emitter data with the total lifetime
+  \param dt - time passed
+  \param pLifeTime - current lifetime of the emitter
+  \param pIsActive - set to false when the emitter dies
+  *************************************************************************************/
+  void UpdateEmitterLifetime(const emitterData& pEmitterData, float dt, float& pLifeTime, bool& pIsActive);
+
+  /*!***********************************************************************************
+  \brief  Moves an emitter along its waves, it's paused for the wave off time after
+          every wave on time
+
+  \param pEmitterData - emitter data with the wave times
+  \param dt - time passed
+  \param pIsActive - if the emitter is active (the waves stand still otherwise)
+  \param pWaveTime - time into the current wave (or pause between waves)
+  \param pIsPaused - if the emitter is between two waves
+  *************************************************************************************/
+  void UpdateWaveTiming(const emitterData& pEmitterData, float dt, bool pIsActive, float& pWaveTime, bool& pIsPaused);
+}
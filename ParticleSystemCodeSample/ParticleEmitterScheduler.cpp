@@ -0,0 +1,132 @@
+/*!****************************************************************************************
+\file       ParticleEmitterScheduler.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particleEmitterScheduler class.
+******************************************************************************************/
+
+#include "ParticleEmitterScheduler.h"
+#include "ParticleEmitter.h"
+#include "ParticleJobSystem.h"
+
+particleEmitterScheduler::particleEmitterScheduler(float pOffscreenTickTime) : m_hasVisibleBounds(false),
+  m_offscreenTickTime(pOffscreenTickTime)
+{
+  m_visibleBounds[0] = m_visibleBounds[1] = m_visibleBounds[2] = m_visibleBounds[3] = 0.0f;
+}
+
+particleEmitterScheduler::~particleEmitterScheduler()
+{
+  for (scheduledEmitter& awake : m_awakeEmitters)
+    awake.m_emitter->SetScheduler(nullptr);
+  for (scheduledEmitter& sleeping : m_sleepingEmitters)
+    sleeping.m_emitter->SetScheduler(nullptr);
+}
+
+void particleEmitterScheduler::AddEmitter(particleEmitter& pEmitter, transform& pTransform)
+{
+  scheduledEmitter newEmitter = { &pEmitter, &pTransform, 0.0f };
+  m_awakeEmitters.push_back(newEmitter);
+  pEmitter.SetScheduler(this);
+}
+
+void particleEmitterScheduler::RemoveEmitter(particleEmitter& pEmitter)
+{
+  for (std::vector<scheduledEmitter>* emitters : { &m_awakeEmitters, &m_sleepingEmitters })
+  {
+    for (unsigned i = 0; i < emitters->size(); ++i)
+    {
+      if ((*emitters)[i].m_emitter != &pEmitter)
+        continue;
+
+      (*emitters)[i] = emitters->back();
+      emitters->pop_back();
+      pEmitter.SetScheduler(nullptr);
+      return;
+    }
+  }
+}
+
+void particleEmitterScheduler::WakeEmitter(particleEmitter& pEmitter)
+{
+  for (unsigned i = 0; i < m_sleepingEmitters.size(); ++i)
+  {
+    if (m_sleepingEmitters[i].m_emitter != &pEmitter)
+      continue;
+
+      // time spent asleep isn't caught up on, nothing happened in it
+    m_sleepingEmitters[i].m_pendingTime = 0.0f;
+    m_awakeEmitters.push_back(m_sleepingEmitters[i]);
+
+    m_sleepingEmitters[i] = m_sleepingEmitters.back();
+    m_sleepingEmitters.pop_back();
+    return;
+  }
+}
+
+void particleEmitterScheduler::SetVisibleBounds(float pMinX, float pMinY, float pMaxX, float pMaxY)
+{
+  m_visibleBounds[0] = pMinX;
+  m_visibleBounds[1] = pMinY;
+  m_visibleBounds[2] = pMaxX;
+  m_visibleBounds[3] = pMaxY;
+  m_hasVisibleBounds = true;
+}
+
+void particleEmitterScheduler::Update(float dt, particleJobSystem& pJobSystem)
+{
+    // emitters that can be seen update every frame, the others once enough time piled up
+  m_dueEmitters.clear();
+  for (unsigned i = 0; i < m_awakeEmitters.size(); ++i)
+  {
+    m_awakeEmitters[i].m_pendingTime += dt;
+
+    if ((m_awakeEmitters[i].m_pendingTime >= m_offscreenTickTime) || IsVisible(m_awakeEmitters[i]))
+      m_dueEmitters.push_back(i);
+  }
+
+  pJobSystem.ParallelFor(static_cast<unsigned>(m_dueEmitters.size()), [this](unsigned i)
+  {
+    scheduledEmitter& dueEmitter = m_awakeEmitters[m_dueEmitters[i]];
+
+    dueEmitter.m_emitter->UpdateParticleEmitter(dueEmitter.m_pendingTime, *dueEmitter.m_transform);
+    dueEmitter.m_pendingTime = 0.0f;
+  });
+
+    // emitters that are stopped and have no particles left won't change until they're
+    // restarted
+  for (unsigned i = static_cast<unsigned>(m_awakeEmitters.size()); i--; )
+  {
+    if (!m_awakeEmitters[i].m_emitter->IsDormant())
+      continue;
+
+    m_sleepingEmitters.push_back(m_awakeEmitters[i]);
+    m_awakeEmitters[i] = m_awakeEmitters.back();
+    m_awakeEmitters.pop_back();
+  }
+}
+
+unsigned particleEmitterScheduler::GetAwakeCount() const
+{
+  return static_cast<unsigned>(m_awakeEmitters.size());
+}
+
+unsigned particleEmitterScheduler::GetSleepingCount() const
+{
+  return static_cast<unsigned>(m_sleepingEmitters.size());
+}
+
+bool particleEmitterScheduler::IsVisible(const scheduledEmitter& pEmitter) const
+{
+  if (!m_hasVisibleBounds)
+    return true;
+
+  float bounds[4];
+  pEmitter.m_emitter->GetBounds(*pEmitter.m_transform, bounds);
+
+  return (bounds[2] >= m_visibleBounds[0]) && (bounds[0] <= m_visibleBounds[2]) &&
+         (bounds[3] >= m_visibleBounds[1]) && (bounds[1] <= m_visibleBounds[3]);
+}
@@ -0,0 +1,134 @@
+/*!****************************************************************************************
+\file       ParticleEmitterScheduler.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particleEmitterScheduler class. Decides which of the
+emitters placed in a level need to be updated in a frame: emitters with nothing left to do
+are put to sleep and emitters that can't be seen are updated less often.
+******************************************************************************************/
+#pragma once
+#include <vector>
+
+// forward declarations
+class particleEmitter;
+class particleJobSystem;
+class transform;
+
+/*!*************************************************************************************
+\par class: particleEmitterScheduler
+
+\brief  Keeps the emitters of a level in two lists. Awake emitters are updated, sleeping
+        ones (stopped with no particles left) aren't looked at at all until they're
+        woken up by RestartEmitter (which is what trigger events call as well). Awake
+        emitters outside of the visible bounds collect their time and only update once
+        enough of it piled up, or right away once they come back into view, so they
+        catch up in a single big step.
+\par baseClass: true
+***************************************************************************************/
+class particleEmitterScheduler
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for the scheduler
+
+  \param pOffscreenTickTime - time between updates of emitters that can't be seen
+  *************************************************************************************/
+  explicit particleEmitterScheduler(float pOffscreenTickTime = 0.25f);
+
+  /*!***********************************************************************************
+  \brief  destructor for the scheduler, lets go of all emitters still in it
+  *************************************************************************************/
+  ~particleEmitterScheduler();
+
+  particleEmitterScheduler(const particleEmitterScheduler&) = delete;
+  particleEmitterScheduler& operator=(const particleEmitterScheduler&) = delete;
+
+  /*!***********************************************************************************
+  \brief  Adds an emitter to the scheduler (it starts out awake)
+
+  \param pEmitter - emitter to schedule
+  \param pTransform - transform the emitter spawns its particles from
+  *************************************************************************************/
+  void AddEmitter(particleEmitter& pEmitter, transform& pTransform);
+
+  /*!***********************************************************************************
+  \brief  Removes an emitter from the scheduler
+
+  \param pEmitter - emitter to remove
+  *************************************************************************************/
+  void RemoveEmitter(particleEmitter& pEmitter);
+
+  /*!***********************************************************************************
+  \brief  Moves a sleeping emitter back into the update (does nothing if it's awake).
+          Called by particleEmitter::RestartEmitter, so it can't be called while the
+          scheduler is updating.
+
+  \param pEmitter - emitter to wake up
+  *************************************************************************************/
+  void WakeEmitter(particleEmitter& pEmitter);
+
+  /*!***********************************************************************************
+  \brief  Sets the part of the world that can be seen (usually the camera's view plus a
+          bit of margin). Emitters whose particles can't reach into it are updated less
+          often.
+
+  \param pMinX - left of the visible bounds
+  \param pMinY - bottom of the visible bounds
+  \param pMaxX - right of the visible bounds
+  \param pMaxY - top of the visible bounds
+  *************************************************************************************/
+  void SetVisibleBounds(float pMinX, float pMinY, float pMaxX, float pMaxY);
+
+  /*!***********************************************************************************
+  \brief  Updates every awake emitter that's due on all workers of the job system and
+          puts the emitters that have nothing left to do to sleep
+
+  \param dt - time passed since last frame
+  \param pJobSystem - job system to spread the emitters across
+  *************************************************************************************/
+  void Update(float dt, particleJobSystem& pJobSystem);
+
+  /*!***********************************************************************************
+  \brief  Gets the number of emitters being updated
+
+  \return number of awake emitters
+  *************************************************************************************/
+  unsigned GetAwakeCount() const;
+
+  /*!***********************************************************************************
+  \brief  Gets the number of emitters that aren't updated until they're woken up
+
+  \return number of sleeping emitters
+  *************************************************************************************/
+  unsigned GetSleepingCount() const;
+
+private:
+  /*!***********************************************************************************
+  \brief  an emitter along with how long it hasn't been updated for
+  *************************************************************************************/
+  struct scheduledEmitter
+  {
+    particleEmitter* m_emitter; //!< emitter being scheduled
+    transform* m_transform;     //!< transform the emitter spawns its particles from
+    float m_pendingTime;        //!< time passed since the emitter was last updated
+  };
+
+  /*!***********************************************************************************
+  \brief  Checks if the particles of an emitter can reach into the visible bounds
+
+  \param pEmitter - emitter to check
+  \return if the emitter can be seen
+  *************************************************************************************/
+  bool IsVisible(const scheduledEmitter& pEmitter) const;
+
+  std::vector<scheduledEmitter> m_awakeEmitters;    //!< emitters being updated
+  std::vector<scheduledEmitter> m_sleepingEmitters; //!< emitters waiting to be woken up
+  std::vector<unsigned> m_dueEmitters;              //!< awake emitters updated this frame
+
+  float m_visibleBounds[4];  //!< part of the world that can be seen (min x, min y, max x, max y)
+  bool m_hasVisibleBounds;   //!< if the visible bounds were set (everything is visible until then)
+  float m_offscreenTickTime; //!< time between updates of emitters that can't be seen
+};
@@ -0,0 +1,51 @@
+/*!****************************************************************************************
+\file       ParticleGPURing.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particleGPURing class.
+******************************************************************************************/
+
+#include "ParticleGPURing.h"
+
+particleGPURing::particleGPURing(shaderHandler::gPUData* pMappedMemory, unsigned pCapacity) : m_memory(pMappedMemory), m_capacity(pCapacity),
+  m_writeFrame(0), m_uploadFrame(1), m_newestFrame(2)
+{
+  for (unsigned i = 0; i < c_frameCount; ++i)
+    m_counts[i] = 0;
+}
+
+shaderHandler::gPUData* particleGPURing::BeginWrite()
+{
+  return m_memory + m_writeFrame * m_capacity;
+}
+
+void particleGPURing::EndWrite(unsigned pCount)
+{
+  m_counts[m_writeFrame] = (pCount < m_capacity) ? pCount : m_capacity;
+
+    // the written frame becomes the newest one, the one it replaces (which was never
+    // uploaded if it's still fresh) is written next. release makes the particles and
+    // count visible to the reader
+  m_writeFrame = m_newestFrame.exchange(m_writeFrame | c_freshFrame, std::memory_order_acq_rel) & ~c_freshFrame;
+}
+
+bool particleGPURing::BeginUpload(const shaderHandler::gPUData*& pData, unsigned& pCount)
+{
+    // nothing new to upload
+  if (!(m_newestFrame.load(std::memory_order_relaxed) & c_freshFrame))
+    return false;
+
+  m_uploadFrame = m_newestFrame.exchange(m_uploadFrame, std::memory_order_acq_rel) & ~c_freshFrame;
+
+  pData = m_memory + m_uploadFrame * m_capacity;
+  pCount = m_counts[m_uploadFrame];
+  return true;
+}
+
+unsigned particleGPURing::GetCapacity() const
+{
+  return m_capacity;
+}
@@ -0,0 +1,90 @@
+/*!****************************************************************************************
+\file       ParticleGPURing.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particleGPURing class. Lets an emitter write its gpu data
+straight into a persistently mapped staging buffer the renderer owns, without the
+emitter's update and the renderer's upload ever waiting on each other.
+******************************************************************************************/
+#pragma once
+#include <atomic>
+#include "../Renderer/Renderer.h"
+
+/*!*************************************************************************************
+\par class: particleGPURing
+
+\brief  Triple buffer over memory the caller mapped: one frame is being written by the
+        emitter, one is being uploaded by the renderer and the third holds the newest
+        finished frame. Finishing a write swaps the written frame with the newest one
+        and starting an upload swaps the uploaded frame with it, both with a single
+        atomic exchange, so neither side ever blocks. Only frames written since the last
+        upload are handed out, so nothing is uploaded again when an emitter didn't
+        update (sleeping or skipping frames for its level of detail).
+
+        There can only be one writer and one reader.
+\par baseClass: true
+***************************************************************************************/
+class particleGPURing
+{
+public:
+  static const unsigned c_frameCount = 3; //!< number of frames in the ring
+
+  /*!***********************************************************************************
+  \brief  constructor for the ring
+
+  \param pMappedMemory - memory for c_frameCount * pCapacity particles (usually a
+         persistently mapped staging buffer, the ring doesn't own it)
+  \param pCapacity - most particles a frame can hold
+  *************************************************************************************/
+  particleGPURing(shaderHandler::gPUData* pMappedMemory, unsigned pCapacity);
+
+  particleGPURing(const particleGPURing&) = delete;
+  particleGPURing& operator=(const particleGPURing&) = delete;
+
+  /*!***********************************************************************************
+  \brief  Gets the frame the writer can fill (writer side, never waits)
+
+  \return first particle of the frame (GetCapacity particles long)
+  *************************************************************************************/
+  shaderHandler::gPUData* BeginWrite();
+
+  /*!***********************************************************************************
+  \brief  Hands the frame being written over to the reader (writer side)
+
+  \param pCount - number of particles written to the frame
+  *************************************************************************************/
+  void EndWrite(unsigned pCount);
+
+  /*!***********************************************************************************
+  \brief  Takes the newest frame for uploading (reader side, never waits). The frame
+          taken by the last call is given back, so only call this once the gpu is done
+          reading from it.
+
+  \param pData - set to the first particle of the frame
+  \param pCount - set to the number of particles in the frame
+  \return false if nothing was written since the last upload (pData and pCount are left
+          alone then, the last upload is still up to date)
+  *************************************************************************************/
+  bool BeginUpload(const shaderHandler::gPUData*& pData, unsigned& pCount);
+
+  /*!***********************************************************************************
+  \brief  Gets the most particles a frame can hold
+
+  \return capacity of a frame
+  *************************************************************************************/
+  unsigned GetCapacity() const;
+
+private:
+  static const unsigned c_freshFrame = 4; //!< flag on the newest frame set when it wasn't uploaded yet
+
+  shaderHandler::gPUData* m_memory; //!< memory of all frames, one after the other
+  unsigned m_capacity;              //!< most particles a frame can hold
+  unsigned m_counts[c_frameCount];  //!< number of particles written to every frame
+
+  unsigned m_writeFrame;               //!< frame owned by the writer
+  unsigned m_uploadFrame;              //!< frame owned by the reader
+  std::atomic<unsigned> m_newestFrame; //!< newest finished frame (plus c_freshFrame if it's new)
+};
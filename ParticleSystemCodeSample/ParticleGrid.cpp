@@ -0,0 +1,83 @@
+/*!****************************************************************************************
+\file       ParticleGrid.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particleGrid class.
+******************************************************************************************/
+
+#include "ParticleGrid.h"
+#include "ParticleStorage.h"
+#include <algorithm>
+
+particleGrid::particleGrid(particleArena* pArena) : m_inverseCellSize(1.0f), m_bucketMask(0),
+  m_bucketStarts(particleArenaAllocator<unsigned>(pArena ? pArena : &particleArena::GetGlobalArena())),
+  m_entryBuckets(m_bucketStarts.get_allocator()), m_particleIndices(m_bucketStarts.get_allocator()),
+  m_positionX(floatVector::allocator_type(m_bucketStarts.get_allocator())), m_positionY(m_positionX.get_allocator())
+{
+}
+
+void particleGrid::Build(const particleStorage& pStorage, const particleSpan* pSpans, unsigned pSpanCount, float pCellSize)
+{
+  unsigned count = 0;
+  for (unsigned span = 0; span < pSpanCount; ++span)
+    count += pSpans[span].m_end - pSpans[span].m_begin;
+
+    // about two buckets per particle keeps the buckets short (the vectors only grow, so
+    // this doesn't allocate once the emitter is warmed up)
+  unsigned bucketCount = 64;
+  while (bucketCount < count * 2)
+    bucketCount *= 2;
+
+  m_inverseCellSize = 1.0f / pCellSize;
+  m_bucketMask = bucketCount - 1;
+
+  m_bucketStarts.assign(bucketCount + 1, 0);
+  m_entryBuckets.resize(count);
+  m_particleIndices.resize(count);
+  m_positionX.resize(count);
+  m_positionY.resize(count);
+
+    // counting the particles in every bucket
+  unsigned entry = 0;
+  for (unsigned span = 0; span < pSpanCount; ++span)
+  {
+    for (unsigned i = pSpans[span].m_begin; i < pSpans[span].m_end; ++i, ++entry)
+    {
+      int cellX = static_cast<int>(std::floor(pStorage.m_positionX[i] * m_inverseCellSize));
+      int cellY = static_cast<int>(std::floor(pStorage.m_positionY[i] * m_inverseCellSize));
+
+      m_entryBuckets[entry] = GetBucket(cellX, cellY);
+      ++m_bucketStarts[m_entryBuckets[entry] + 1];
+    }
+  }
+
+    // prefix sum turns the counts into where every bucket starts
+  for (unsigned bucket = 0; bucket < bucketCount; ++bucket)
+    m_bucketStarts[bucket + 1] += m_bucketStarts[bucket];
+
+    // scattering the particles into their buckets. the starts are used as cursors and
+    // end up shifted by one bucket, so they're shifted back after
+  entry = 0;
+  for (unsigned span = 0; span < pSpanCount; ++span)
+  {
+    for (unsigned i = pSpans[span].m_begin; i < pSpans[span].m_end; ++i, ++entry)
+    {
+      unsigned sortedEntry = m_bucketStarts[m_entryBuckets[entry]]++;
+
+      m_particleIndices[sortedEntry] = i;
+      m_positionX[sortedEntry] = pStorage.m_positionX[i];
+      m_positionY[sortedEntry] = pStorage.m_positionY[i];
+    }
+  }
+
+  std::copy_backward(m_bucketStarts.begin(), m_bucketStarts.end() - 1, m_bucketStarts.end());
+  m_bucketStarts[0] = 0;
+}
+
+unsigned particleGrid::size() const
+{
+  return static_cast<unsigned>(m_particleIndices.size());
+}
@@ -0,0 +1,126 @@
+/*!****************************************************************************************
+\file       ParticleGrid.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particleGrid class. A uniform grid of hashed cells the
+particles of an emitter are sorted into, so a particle only has to look at the particles
+in the cells around it to find the ones it touches.
+******************************************************************************************/
+#pragma once
+#include <cmath>
+#include <vector>
+#include "ParticleArena.h"
+
+// forward declarations
+struct particleStorage;
+struct particleSpan;
+
+/*!*************************************************************************************
+\par class: particleGrid
+
+\brief  Spatial hash grid rebuilt from scratch every frame. The particles are sorted by
+        cell with a counting sort (count, prefix sum, scatter), so building it is O(n)
+        and the particles of a cell end up next to each other in memory. Once built it's
+        only read, so any number of threads can query it at the same time.
+\par baseClass: true
+***************************************************************************************/
+class particleGrid
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for the grid
+
+  \param pArena - arena the grid allocates from (nullptr for the global arena)
+  *************************************************************************************/
+  explicit particleGrid(particleArena* pArena = nullptr);
+
+  /*!***********************************************************************************
+  \brief  Sorts particles into the grid (anything sorted in before is thrown away)
+
+  \param pStorage - storage holding the particles
+  \param pSpans - ranges of particles to sort in
+  \param pSpanCount - number of ranges
+  \param pCellSize - width and height of a cell (at least the biggest distance that
+         is queried)
+  *************************************************************************************/
+  void Build(const particleStorage& pStorage, const particleSpan* pSpans, unsigned pSpanCount, float pCellSize);
+
+  /*!***********************************************************************************
+  \brief  Calls pFunction(index, x, y) for every particle in the cell of a point and the 8
+          cells around it (so every particle closer than the cell size is found, plus
+          some further away ones)
+
+  \param pX - x of the point
+  \param pY - y of the point
+  \param pFunction - function called with the storage index and position of a particle
+  *************************************************************************************/
+  template <typename Function>
+  void ForEachNeighbor(float pX, float pY, Function pFunction) const
+  {
+    if (m_particleIndices.empty())
+      return;
+
+    int cellX = static_cast<int>(std::floor(pX * m_inverseCellSize));
+    int cellY = static_cast<int>(std::floor(pY * m_inverseCellSize));
+
+      // cells can hash to the same bucket, every bucket is only visited once
+    unsigned buckets[9];
+    unsigned bucketCount = 0;
+
+    for (int offsetY = -1; offsetY <= 1; ++offsetY)
+    {
+      for (int offsetX = -1; offsetX <= 1; ++offsetX)
+      {
+        unsigned bucket = GetBucket(cellX + offsetX, cellY + offsetY);
+
+        bool isVisited = false;
+        for (unsigned i = 0; i < bucketCount; ++i)
+          isVisited = isVisited || (buckets[i] == bucket);
+
+        if (!isVisited)
+          buckets[bucketCount++] = bucket;
+      }
+    }
+
+    for (unsigned i = 0; i < bucketCount; ++i)
+    {
+      for (unsigned entry = m_bucketStarts[buckets[i]]; entry < m_bucketStarts[buckets[i] + 1]; ++entry)
+        pFunction(m_particleIndices[entry], m_positionX[entry], m_positionY[entry]);
+    }
+  }
+
+  /*!***********************************************************************************
+  \brief  Gets the number of particles sorted into the grid
+
+  \return number of particles
+  *************************************************************************************/
+  unsigned size() const;
+
+private:
+  typedef std::vector<unsigned, particleArenaAllocator<unsigned> > indexVector;
+  typedef std::vector<float, particleArenaAllocator<float> > floatVector;
+
+  /*!***********************************************************************************
+  \brief  Gets the bucket a cell hashes to
+
+  \param pCellX - x coordinate of the cell
+  \param pCellY - y coordinate of the cell
+  \return bucket of the cell
+  *************************************************************************************/
+  unsigned GetBucket(int pCellX, int pCellY) const
+  {
+    return ((static_cast<unsigned>(pCellX) * 73856093u) ^ (static_cast<unsigned>(pCellY) * 19349663u)) & m_bucketMask;
+  }
+
+  float m_inverseCellSize; //!< 1 / width of a cell
+  unsigned m_bucketMask;   //!< bucket count - 1 (the bucket count is a power of two)
+
+  indexVector m_bucketStarts;    //!< first entry of every bucket (plus one past the last entry)
+  indexVector m_entryBuckets;    //!< bucket of every particle, in the order they were sorted in
+  indexVector m_particleIndices; //!< storage index of every entry, sorted by bucket
+  floatVector m_positionX;       //!< x position of every entry, sorted by bucket
+  floatVector m_positionY;       //!< y position of every entry, sorted by bucket
+};
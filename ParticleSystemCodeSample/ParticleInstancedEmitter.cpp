@@ -0,0 +1,239 @@
+/*!****************************************************************************************
+\file       ParticleInstancedEmitter.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particleInstancedEmitter class.
+******************************************************************************************/
+
+#include "ParticleInstancedEmitter.h"
+#include "ParticleEmitterCommon.h"
+#include <atomic>
+
+particleInstancedEmitter::particleInstancedEmitter(const emitterDefinition& pDefinition, particleArena* pArena) : m_definition(pDefinition),
+    // the pool grows with the instances, so it starts out empty
+  m_particles(0, pArena), m_particleInstances(indexVector::allocator_type(m_particles.GetArena())),
+  m_particleDataForGPUs(particleGPUDataVector::allocator_type(m_particles.GetArena())), m_liveParticleCount(0), m_jobSystem(nullptr)
+#ifdef PARTICLE_PROFILING
+  , m_profile(pDefinition->m_emitterName)
+#endif
+{
+    // the definition never changes, so the kernel is picked once. every instance steps
+    // with the frame time
+  m_updateKernel = ParticleKernels::GetUpdateKernel(particleEmitter::GetUpdateFeatures(*m_definition) & ~ParticleKernels::uf_fixedStep);
+
+    // the same seed spawns the same particles every run
+  if (m_definition->m_randomSeed)
+    m_random.Seed(m_definition->m_randomSeed);
+  else
+    m_random.Seed(particleRandom::GetUniqueSeed());
+}
+
+unsigned particleInstancedEmitter::AddInstance(const transform& pTransform)
+{
+  particleEmitterInstance instance = { pTransform, 0, 0.0f, 0.0f, 0.0f, !m_definition->m_startOnTrigger, false };
+  m_instances.push_back(instance);
+
+  return static_cast<unsigned>(m_instances.size() - 1);
+}
+
+void particleInstancedEmitter::RemoveInstance(unsigned pInstance)
+{
+    // the instance's particles are killed and removed like the ones that died of old age
+  for (unsigned i = 0; i < m_liveParticleCount; ++i)
+  {
+    if (m_particleInstances[i] == pInstance)
+      m_particles.m_isActive[i] = false;
+  }
+
+  RemoveDeadParticles();
+
+    // the last instance takes the removed one's index, so its particles are relabeled
+  unsigned lastInstance = static_cast<unsigned>(m_instances.size() - 1);
+  if (pInstance != lastInstance)
+  {
+    for (unsigned i = 0; i < m_liveParticleCount; ++i)
+    {
+      if (m_particleInstances[i] == lastInstance)
+        m_particleInstances[i] = pInstance;
+    }
+
+    m_instances[pInstance] = m_instances[lastInstance];
+  }
+
+  m_instances.pop_back();
+}
+
+void particleInstancedEmitter::SetInstanceTransform(unsigned pInstance, const transform& pTransform)
+{
+  m_instances[pInstance].m_transform = pTransform;
+}
+
+void particleInstancedEmitter::RestartInstance(unsigned pInstance)
+{
+  particleEmitterInstance& instance = m_instances[pInstance];
+
+  instance.m_currentLifeTime = 0.0f;
+  instance.m_currentWaveTime = 0.0f;
+  instance.m_timeSinceLastSpawn = 0.0f;
+
+  instance.m_isPaused = false;
+  instance.m_isActive = true;
+}
+
+void particleInstancedEmitter::StopInstance(unsigned pInstance)
+{
+  m_instances[pInstance].m_isActive = false;
+}
+
+unsigned particleInstancedEmitter::GetInstanceCount() const
+{
+  return static_cast<unsigned>(m_instances.size());
+}
+
+void particleInstancedEmitter::UpdateParticleEmitter(float dt)
+{
+    // the frame's stats are handed over to the profiler once the update is done
+  PARTICLE_PROFILE_FRAME(m_profile, nullptr);
+
+    // every instance has room for as many particles as an emitter with the definition,
+    // so the pool only changes size when instances were added or removed
+  unsigned capacity = static_cast<unsigned>(m_instances.size()) * m_definition->m_numberofParticles;
+  if (m_particles.size() != capacity)
+    ResizeParticlePool(capacity);
+
+    // all instances share the forces and colors, so all of their particles are updated
+    // in one go. particles that die are only marked, they're removed all at once afterwards
+  ParticleKernels::updateParameters parameters = { m_definition->m_constantAcceleration, m_definition->m_initialColor, m_definition->m_finalColor, dt };
+  std::atomic<unsigned> deathCount(0);
+
+  ParticleEmitterCommon::RunInChunks(m_jobSystem, 0, m_liveParticleCount, [this, &parameters, &deathCount](unsigned pBegin, unsigned pEnd)
+  {
+    {
+        // the colors and scales are timed along with the integration
+      PARTICLE_PROFILE_PHASE(m_profile, pp_integrate);
+      m_updateKernel(m_particles, pBegin, pEnd, parameters);
+    }
+
+    deathCount += ParticleKernels::MarkDeadParticles(m_particles, pBegin, pEnd);
+  });
+
+  if (deathCount)
+    RemoveDeadParticles();
+
+  UpdateInstances(dt);
+
+    // handing the updated particles over to the renderer. the active particles of all
+    // instances are in [0, live count), which is what the renderer draws
+  ParticleEmitterCommon::RunInChunks(m_jobSystem, 0, m_liveParticleCount, [this](unsigned pBegin, unsigned pEnd)
+  {
+    ParticleEmitterCommon::WriteGPUData(m_particles, pBegin, pEnd, 1.0f, 0.0f, m_particleDataForGPUs.data() + pBegin);
+  });
+}
+
+void particleInstancedEmitter::SetJobSystem(particleJobSystem* pJobSystem)
+{
+  m_jobSystem = pJobSystem;
+}
+
+const emitterDefinition& particleInstancedEmitter::GetDefinition() const
+{
+  return m_definition;
+}
+
+unsigned particleInstancedEmitter::GetLiveParticleCount() const
+{
+  return m_liveParticleCount;
+}
+
+const shaderHandler::gPUData* particleInstancedEmitter::GetLiveGPUData(unsigned& pCount) const
+{
+  pCount = m_liveParticleCount;
+  return m_particleDataForGPUs.data();
+}
+
+particleStorage& particleInstancedEmitter::GetParticles()
+{
+  return m_particles;
+}
+
+void particleInstancedEmitter::ResizeParticlePool(unsigned pCapacity)
+{
+    // no instance holds more particles than its share, so all of them still fit
+  unsigned keptCount = (m_liveParticleCount < pCapacity) ? m_liveParticleCount : pCapacity;
+
+  particleStorage resizedParticles(pCapacity, m_particles.GetArena());
+  resizedParticles.CopyParticles(m_particles, keptCount);
+  m_particles = std::move(resizedParticles);
+
+  m_particleInstances.resize(pCapacity);
+  m_particleDataForGPUs.resize(pCapacity);
+  m_liveParticleCount = keptCount;
+}
+
+void particleInstancedEmitter::RemoveDeadParticles()
+{
+    // dead particles are taken off their instances before the compaction fills their slots
+  for (unsigned i = 0; i < m_liveParticleCount; ++i)
+  {
+    if (!m_particles.m_isActive[i])
+      --m_instances[m_particleInstances[i]].m_liveParticleCount;
+  }
+
+  unsigned liveCount = ParticleKernels::CompactParticles(m_particles, m_liveParticleCount);
+
+    // the instances of the particles that were moved go along with them
+  for (unsigned i = 0; i < m_particles.m_moveCount; ++i)
+    m_particleInstances[m_particles.m_moves[i].m_to] = m_particleInstances[m_particles.m_moves[i].m_from];
+
+  PARTICLE_PROFILE_COUNT(m_profile, pc_deaths, m_liveParticleCount - liveCount);
+  PARTICLE_PROFILE_COUNT(m_profile, pc_swaps, m_particles.m_moveCount);
+  m_liveParticleCount = liveCount;
+}
+
+void particleInstancedEmitter::UpdateInstances(float dt)
+{
+  const emitterData& definition = *m_definition;
+  float timeBetweenParticles = 1.0f / static_cast<float>(definition.m_particlesPerSecond);
+
+  for (unsigned instanceIndex = 0; instanceIndex < m_instances.size(); ++instanceIndex)
+  {
+    particleEmitterInstance& instance = m_instances[instanceIndex];
+    instance.m_timeSinceLastSpawn += dt;
+
+      // time doesn't pile up while the instance isn't spawning, otherwise it would spit
+      // out a burst of particles once it starts again
+    if (!instance.m_isActive || instance.m_isPaused)
+      instance.m_timeSinceLastSpawn = 0.0f;
+    else
+    {
+      PARTICLE_PROFILE_PHASE(m_profile, pp_spawn);
+
+        // particles that don't fit in the instance's share of the pool are dropped
+      unsigned dueCount = ParticleEmitterCommon::TakeDueParticles(instance.m_timeSinceLastSpawn, timeBetweenParticles);
+      unsigned freeCount = definition.m_numberofParticles - instance.m_liveParticleCount;
+      unsigned spawnCount = (dueCount < freeCount) ? dueCount : freeCount;
+
+        // the new particles go right after the active ones, in the order of the instances
+      while (spawnCount)
+      {
+        unsigned batchCount = (spawnCount < ParticleEmitterCommon::c_spawnBatchSize) ? spawnCount : ParticleEmitterCommon::c_spawnBatchSize;
+        particleSpan spans[2] = { { m_liveParticleCount, m_liveParticleCount + batchCount }, { 0, 0 } };
+        ParticleEmitterCommon::SpawnParticleBatch(m_particles, spans, definition, m_random, instance.m_transform);
+
+        for (unsigned i = spans[0].m_begin; i < spans[0].m_end; ++i)
+          m_particleInstances[i] = instanceIndex;
+
+        instance.m_liveParticleCount += batchCount;
+        m_liveParticleCount += batchCount;
+        PARTICLE_PROFILE_COUNT(m_profile, pc_spawns, batchCount);
+        spawnCount -= batchCount;
+      }
+    }
+
+    ParticleEmitterCommon::UpdateEmitterLifetime(definition, dt, instance.m_currentLifeTime, instance.m_isActive);
+    ParticleEmitterCommon::UpdateWaveTiming(definition, dt, instance.m_isActive, instance.m_currentWaveTime, instance.m_isPaused);
+  }
+}
@@ -0,0 +1,202 @@
+/*!****************************************************************************************
+\file       ParticleInstancedEmitter.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particleInstancedEmitter class. Simulates every placement of
+one emitter definition (torches, dust, ...) in a single storage with a single update, and
+hands all of their particles to the renderer as one stream of gpu data.
+******************************************************************************************/
+#pragma once
+#include <vector>
+
+#include "../Transform.h"
+#include "EmitterData.h"
+#include "ParticleStorage.h"
+#include "ParticleArena.h"
+#include "ParticleRandom.h"
+#include "ParticleProfiler.h"
+#include "ParticleKernels.h"
+#include "ParticleEmitter.h"
+
+// forward declarations
+class particleJobSystem;
+
+/*!*************************************************************************************
+\par struct: particleEmitterInstance
+\brief   One placement of an instanced emitter. Only holds what differs between the
+  placements, everything else is in the shared definition.
+
+\par baseClass: true
+***************************************************************************************/
+struct particleEmitterInstance
+{
+  transform m_transform;        //!< transform the instance spawns its particles from
+  unsigned m_liveParticleCount; //!< number of particles of the instance currently active
+  float m_timeSinceLastSpawn;   //!< time since the instance last spawned a particle
+  float m_currentLifeTime;      //!< lifetime of the instance (like an emitter's)
+  float m_currentWaveTime;      //!< time into the current wave (or pause between waves)
+  bool m_isActive;              //!< if the instance spawns particles
+  bool m_isPaused;              //!< if the instance is between two waves
+};
+
+/*!*************************************************************************************
+\par class: particleInstancedEmitter
+
+\brief  Lots of placements of one emitter definition, updated as if they were one
+        emitter. Every instance spawns, ages and caps its particles like a
+        particleEmitter with the definition would, but all particles live in one storage,
+        are moved by one update kernel and written to one stream of gpu data. The
+        particles don't collide, interact with each other, change their level of detail
+        or get depth sorted, and always step with the frame time and are integrated
+        (m_useAnalyticMotion is ignored), so it's meant for the decoration placed all
+        over a level. A single instance writes the same gpu data as a particleEmitter
+        with the definition and without a fixed time step, unless the emitter keeps its
+        particles in a ring buffer (no random particle lifetime range), which orders them
+        differently.
+\par baseClass: true
+***************************************************************************************/
+class particleInstancedEmitter
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for the instanced emitter (it starts out without instances)
+
+  \param pDefinition - definition every instance is placed from
+  \param pArena - arena the particles are allocated from (nullptr for the global arena)
+  *************************************************************************************/
+  particleInstancedEmitter(const emitterDefinition& pDefinition, particleArena* pArena = nullptr);
+
+  /*!***********************************************************************************
+  \brief  Places another instance of the definition
+
+  \param pTransform - transform the instance spawns its particles from
+  \return index of the instance
+  *************************************************************************************/
+  unsigned AddInstance(const transform& pTransform);
+
+  /*!***********************************************************************************
+  \brief  Removes an instance along with its particles. The last instance takes its
+          index. Goes over all particles, so it's meant for when the level changes.
+
+  \param pInstance - index of the instance to remove
+  *************************************************************************************/
+  void RemoveInstance(unsigned pInstance);
+
+  /*!***********************************************************************************
+  \brief  Moves an instance (only the particles it spawns from now on start there)
+
+  \param pInstance - index of the instance
+  \param pTransform - transform the instance spawns its particles from
+  *************************************************************************************/
+  void SetInstanceTransform(unsigned pInstance, const transform& pTransform);
+
+  /*!***********************************************************************************
+  \brief  Starts an instance over, like particleEmitter::RestartEmitter
+
+  \param pInstance - index of the instance
+  *************************************************************************************/
+  void RestartInstance(unsigned pInstance);
+
+  /*!***********************************************************************************
+  \brief  Stops an instance from spawning, its particles live out their lives
+
+  \param pInstance - index of the instance
+  *************************************************************************************/
+  void StopInstance(unsigned pInstance);
+
+  /*!***********************************************************************************
+  \brief  Gets the number of instances
+
+  \return number of instances
+  *************************************************************************************/
+  unsigned GetInstanceCount() const;
+
+  /*!***********************************************************************************
+  \brief  Updates the particles of every instance and writes their gpu data
+
+  \param dt - time passed since last frame
+  *************************************************************************************/
+  void UpdateParticleEmitter(float dt);
+
+  /*!***********************************************************************************
+  \brief  Sets the job system the chunks of particles are spread across
+
+  \param pJobSystem - job system to use (nullptr to update on the calling thread)
+  *************************************************************************************/
+  void SetJobSystem(particleJobSystem* pJobSystem);
+
+  /*!***********************************************************************************
+  \brief  Gets the definition the instances are placed from
+
+  \return shared definition
+  *************************************************************************************/
+  const emitterDefinition& GetDefinition() const;
+
+  /*!***********************************************************************************
+  \brief  Gets the number of particles of all instances currently active
+
+  \return number of active particles
+  *************************************************************************************/
+  unsigned GetLiveParticleCount() const;
+
+  /*!***********************************************************************************
+  \brief  Gets the gpu data of the active particles of all instances, in one stream
+
+  \param pCount - filled with the number of particles to draw
+  \return gpu data of the first active particle
+  *************************************************************************************/
+  const shaderHandler::gPUData* GetLiveGPUData(unsigned& pCount) const;
+
+  /*!***********************************************************************************
+  \brief  Gets the particles of all instances
+
+  \return reference to the particle storage
+  *************************************************************************************/
+  particleStorage& GetParticles();
+
+private:
+  /*!***********************************************************************************
+  \brief  Changes the number of particles the storage can hold (when instances were
+          added or removed)
+
+  \param pCapacity - new number of particles
+  *************************************************************************************/
+  void ResizeParticlePool(unsigned pCapacity);
+
+  /*!***********************************************************************************
+  \brief  Takes the dead particles off the counts of their instances and removes them
+          from the storage
+  *************************************************************************************/
+  void RemoveDeadParticles();
+
+  /*!***********************************************************************************
+  \brief  Spawns the particles every instance is due right after the last active one, at
+          the instance's transform, and moves the instances' lifetimes and waves on, like
+          particleEmitter does for a single emitter
+
+  \param dt - time passed since last frame
+  *************************************************************************************/
+  void UpdateInstances(float dt);
+
+  typedef std::vector<unsigned, particleArenaAllocator<unsigned> > indexVector;
+
+  emitterDefinition m_definition;                 //!< definition shared by every instance
+  std::vector<particleEmitterInstance> m_instances; //!< every placement of the definition
+
+  particleStorage m_particles;                 //!< particles of all instances (structure of arrays)
+  indexVector m_particleInstances;             //!< instance of every particle in the storage
+  particleGPUDataVector m_particleDataForGPUs; //!< gpu data of every particle
+  unsigned m_liveParticleCount;                //!< number of particles currently active
+
+  ParticleKernels::updateKernel m_updateKernel; //!< update kernel compiled for the stages the definition needs
+
+  particleRandom m_random;         //!< random stream of all instances
+  particleJobSystem *m_jobSystem;  //!< job system for updating chunks of particles (can be null)
+
+#ifdef PARTICLE_PROFILING
+  particleEmitterProfile m_profile; //!< counters and phase times of all instances
+#endif
+};
@@ -0,0 +1,161 @@
+/*!****************************************************************************************
+\file       ParticleJobSystem.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particle job system.
+******************************************************************************************/
+
+#include "ParticleJobSystem.h"
+
+namespace
+{
+  thread_local const particleJobSystem* s_workerOwner = nullptr; //!< job system the current thread works for
+  thread_local unsigned s_workerIndex = 0;                        //!< index of the current worker thread
+}
+
+particleJobSystem::particleJobSystem(unsigned pWorkerCount) : m_queuedJobCount(0), m_isShuttingDown(false)
+{
+    // one queue per worker and one shared by every other thread
+  for (unsigned i = 0; i <= pWorkerCount; ++i)
+    m_queues.push_back(std::unique_ptr<jobQueue>(new jobQueue));
+
+  for (unsigned i = 0; i < pWorkerCount; ++i)
+    m_workers.push_back(std::thread(&particleJobSystem::WorkerLoop, this, i));
+}
+
+particleJobSystem::~particleJobSystem()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+    m_isShuttingDown = true;
+  }
+  m_wakeUp.notify_all();
+
+  for (auto& worker : m_workers)
+    worker.join();
+}
+
+void particleJobSystem::ParallelFor(unsigned pCount, const std::function<void(unsigned)>& pJob)
+{
+  if (!pCount)
+    return;
+
+    // nothing to share the work with
+  if (m_workers.empty() || pCount == 1)
+  {
+    for (unsigned i = 0; i < pCount; ++i)
+      pJob(i);
+    return;
+  }
+
+  std::atomic<unsigned> remainingJobs(pCount);
+  unsigned currentQueue = GetCurrentQueue();
+  m_queuedJobCount += pCount;
+
+    // spreading the jobs over all the queues so the workers don't fight over one lock
+  for (unsigned i = 0; i < pCount; ++i)
+  {
+    job newJob = { &pJob, i, &remainingJobs };
+    jobQueue& queue = *m_queues[(currentQueue + i) % m_queues.size()];
+
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+    queue.m_jobs.push_back(newJob);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+  }
+  m_wakeUp.notify_all();
+
+    // helping out until every job of this ParallelFor is done
+  while (remainingJobs.load(std::memory_order_acquire))
+  {
+    if (!RunNextJob(currentQueue))
+      std::this_thread::yield();
+  }
+}
+
+unsigned particleJobSystem::GetWorkerCount() const
+{
+  return static_cast<unsigned>(m_workers.size());
+}
+
+unsigned particleJobSystem::GetDefaultWorkerCount()
+{
+  unsigned coreCount = std::thread::hardware_concurrency();
+  return coreCount > 1 ? coreCount - 1 : 0;
+}
+
+bool particleJobSystem::PopJob(unsigned pQueue, job& pJob)
+{
+  jobQueue& queue = *m_queues[pQueue];
+  std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+  if (queue.m_jobs.empty())
+    return false;
+
+  pJob = queue.m_jobs.back();
+  queue.m_jobs.pop_back();
+  --m_queuedJobCount;
+  return true;
+}
+
+bool particleJobSystem::StealJob(unsigned pThief, job& pJob)
+{
+  for (unsigned i = 1; i < m_queues.size(); ++i)
+  {
+    jobQueue& queue = *m_queues[(pThief + i) % m_queues.size()];
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+    if (queue.m_jobs.empty())
+      continue;
+
+    pJob = queue.m_jobs.front();
+    queue.m_jobs.pop_front();
+    --m_queuedJobCount;
+    return true;
+  }
+
+  return false;
+}
+
+bool particleJobSystem::RunNextJob(unsigned pQueue)
+{
+  job currentJob;
+  if (!PopJob(pQueue, currentJob) && !StealJob(pQueue, currentJob))
+    return false;
+
+  (*currentJob.m_function)(currentJob.m_index);
+  currentJob.m_remainingJobs->fetch_sub(1, std::memory_order_release);
+  return true;
+}
+
+unsigned particleJobSystem::GetCurrentQueue() const
+{
+  if (s_workerOwner == this)
+    return s_workerIndex;
+
+  return static_cast<unsigned>(m_queues.size() - 1);
+}
+
+void particleJobSystem::WorkerLoop(unsigned pWorker)
+{
+  s_workerOwner = this;
+  s_workerIndex = pWorker;
+
+  for (;;)
+  {
+    if (RunNextJob(pWorker))
+      continue;
+
+      // sleeping until there's something to do
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_wakeUp.wait(lock, [this]() { return m_isShuttingDown || m_queuedJobCount.load() > 0; });
+
+    if (m_isShuttingDown && !m_queuedJobCount.load())
+      return;
+  }
+}
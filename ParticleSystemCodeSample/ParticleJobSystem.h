@@ -0,0 +1,141 @@
+/*!****************************************************************************************
+\file       ParticleJobSystem.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particle job system. A small work stealing thread pool used
+to update particle emitters (and big ranges of particles) on all cores.
+******************************************************************************************/
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!*************************************************************************************
+\par class: particleJobSystem
+
+\brief  Thread pool where every worker has its own queue of jobs. Workers take jobs from
+        the back of their own queue and steal from the front of the others when theirs
+        is empty. A thread waiting on its jobs helps out with any queued job, so jobs
+        can start more jobs without dead locking.
+\par baseClass: true
+***************************************************************************************/
+class particleJobSystem
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for the job system, starts up the worker threads
+
+  \param pWorkerCount - number of worker threads (the thread waiting on jobs works as
+         well, so 0 runs everything on the calling thread)
+  *************************************************************************************/
+  explicit particleJobSystem(unsigned pWorkerCount = GetDefaultWorkerCount());
+
+  /*!***********************************************************************************
+  \brief  destructor for the job system, finishes all queued jobs and joins the workers
+  *************************************************************************************/
+  ~particleJobSystem();
+
+  particleJobSystem(const particleJobSystem&) = delete;
+  particleJobSystem& operator=(const particleJobSystem&) = delete;
+
+  /*!***********************************************************************************
+  \brief  Runs pJob(i) for every i in [0, pCount) across the workers. Only returns once
+          every job is done.
+
+  \param pCount - number of jobs
+  \param pJob - function to run for each job index
+  *************************************************************************************/
+  void ParallelFor(unsigned pCount, const std::function<void(unsigned)>& pJob);
+
+  /*!***********************************************************************************
+  \brief  Gets the number of worker threads
+
+  \return number of worker threads
+  *************************************************************************************/
+  unsigned GetWorkerCount() const;
+
+  /*!***********************************************************************************
+  \brief  Gets the number of workers to use by default (one less than the number of
+          cores, since the main thread works too)
+
+  \return default number of worker threads
+  *************************************************************************************/
+  static unsigned GetDefaultWorkerCount();
+
+private:
+  /*!***********************************************************************************
+  \brief  a single job, one index of a ParallelFor
+  *************************************************************************************/
+  struct job
+  {
+    const std::function<void(unsigned)>* m_function; //!< function to run
+    unsigned m_index;                                //!< index to run the function with
+    std::atomic<unsigned>* m_remainingJobs;          //!< jobs left in the ParallelFor
+  };
+
+  /*!***********************************************************************************
+  \brief  queue of jobs owned by a single thread
+  *************************************************************************************/
+  struct jobQueue
+  {
+    std::mutex m_mutex;      //!< lock for the queue
+    std::deque<job> m_jobs;  //!< jobs waiting to run
+  };
+
+  /*!***********************************************************************************
+  \brief  Takes the newest job from a queue
+
+  \param pQueue - index of the queue
+  \param pJob - job taken
+  \return if a job was taken
+  *************************************************************************************/
+  bool PopJob(unsigned pQueue, job& pJob);
+
+  /*!***********************************************************************************
+  \brief  Takes the oldest job from any queue other than the thief's
+
+  \param pThief - index of the queue of the thread stealing
+  \param pJob - job taken
+  \return if a job was taken
+  *************************************************************************************/
+  bool StealJob(unsigned pThief, job& pJob);
+
+  /*!***********************************************************************************
+  \brief  Takes a job from the own queue or steals one and runs it
+
+  \param pQueue - index of the queue of the thread looking for work
+  \return if a job was run
+  *************************************************************************************/
+  bool RunNextJob(unsigned pQueue);
+
+  /*!***********************************************************************************
+  \brief  Gets the index of the queue of the calling thread (threads that aren't workers
+          share the last queue)
+
+  \return index of the queue
+  *************************************************************************************/
+  unsigned GetCurrentQueue() const;
+
+  /*!***********************************************************************************
+  \brief  main loop of every worker thread
+
+  \param pWorker - index of the worker
+  *************************************************************************************/
+  void WorkerLoop(unsigned pWorker);
+
+  std::vector<std::unique_ptr<jobQueue> > m_queues; //!< one queue per worker plus a shared one
+  std::vector<std::thread> m_workers;                //!< worker threads
+
+  std::atomic<unsigned> m_queuedJobCount; //!< number of jobs sitting in the queues
+  std::mutex m_sleepMutex;                //!< lock for workers going to sleep
+  std::condition_variable m_wakeUp;       //!< wakes up sleeping workers when jobs are queued
+  bool m_isShuttingDown;                  //!< tells the workers to stop
+};
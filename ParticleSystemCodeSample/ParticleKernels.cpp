@@ -0,0 +1,1490 @@
+/*!****************************************************************************************
+\file       ParticleKernels.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particle kernels. Every kernel has a scalar, SSE2 and
+AVX2 version. The SIMD versions handle the leftover particles with the scalar version,
+the AVX2 ones clear the upper halves of the ymm registers before they do.
+******************************************************************************************/
+
+#include "ParticleKernels.h"
+#include "ParticleStorage.h"
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+  #define PARTICLE_KERNELS_X86
+  #include <immintrin.h>
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+    #define PARTICLE_TARGET_AVX2
+  #else
+    #define PARTICLE_TARGET_AVX2 __attribute__((target("avx2")))
+  #endif
+#endif
+
+namespace
+{
+  /*!***********************************************************************************
+  \brief  all the views into the storage a kernel needs for a range of particles
+  *************************************************************************************/
+  struct kernelStreams
+  {
+    kernelStreams(particleStorage& pStorage) :
+      m_positionX(pStorage.m_positionX), m_positionY(pStorage.m_positionY),
+      m_oldPositionX(pStorage.m_oldPositionX), m_oldPositionY(pStorage.m_oldPositionY),
+      m_velocityX(pStorage.m_velocityX), m_velocityY(pStorage.m_velocityY),
+      m_forceX(pStorage.m_forceX), m_forceY(pStorage.m_forceY),
+      m_rotation(pStorage.m_rotation), m_angularVelocity(pStorage.m_angularVelocity),
+      m_currentLifetime(pStorage.m_currentLifetime), m_totalLifetime(pStorage.m_totalLifetime),
+      m_randomScale(pStorage.m_randomScale), m_scale(pStorage.m_scale),
+      m_colorR(pStorage.m_colorR), m_colorG(pStorage.m_colorG),
+      m_colorB(pStorage.m_colorB), m_colorA(pStorage.m_colorA),
+      m_isActive(pStorage.m_isActive)
+    {
+    }
+
+    float *m_positionX, *m_positionY;
+    float *m_oldPositionX, *m_oldPositionY;
+    float *m_velocityX, *m_velocityY;
+    float *m_forceX, *m_forceY;
+    float *m_rotation, *m_angularVelocity;
+    float *m_currentLifetime, *m_totalLifetime;
+    float *m_randomScale, *m_scale;
+    float *m_colorR, *m_colorG, *m_colorB, *m_colorA;
+    unsigned char *m_isActive;
+  };
+
+  /*!***********************************************************************************
+  \brief  index of the lowest set bit (pMask can't be 0)
+  *************************************************************************************/
+  unsigned LowestBit(unsigned pMask)
+  {
+  #if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, pMask);
+    return index;
+  #else
+    return __builtin_ctz(pMask);
+  #endif
+  }
+
+  /*!***********************************************************************************
+  \brief  index of the highest set bit (pMask can't be 0)
+  *************************************************************************************/
+  unsigned HighestBit(unsigned pMask)
+  {
+  #if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, pMask);
+    return index;
+  #else
+    return 31 - __builtin_clz(pMask);
+  #endif
+  }
+
+  /////////////////////////////////////////////////////////////////////////////////////
+  // scalar kernels
+  /////////////////////////////////////////////////////////////////////////////////////
+
+  void UpdateLifetimesScalar(kernelStreams& s, unsigned pBegin, unsigned pEnd, float dt)
+  {
+    for (unsigned i = pBegin; i < pEnd; ++i)
+      s.m_currentLifetime[i] += dt;
+  }
+
+  template <unsigned t_features>
+  void UpdateParticlesScalar(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::updateParameters& pParameters)
+  {
+    const vector4& initialColor = pParameters.m_initialColor;
+    const vector4& finalColor = pParameters.m_finalColor;
+    float dt = pParameters.m_dt;
+    float forceX = pParameters.m_accumulatedForce.x * (dt / 2.0f);
+    float forceY = pParameters.m_accumulatedForce.y * (dt / 2.0f);
+
+    for (unsigned i = pBegin; i < pEnd; ++i)
+    {
+      s.m_currentLifetime[i] += dt;
+
+      if (t_features & (ParticleKernels::uf_colors | ParticleKernels::uf_scales))
+      {
+        float t = s.m_currentLifetime[i] / s.m_totalLifetime[i];
+
+        if (t_features & ParticleKernels::uf_colors)
+        {
+          s.m_colorR[i] = initialColor.x + (finalColor.x - initialColor.x) * t;
+          s.m_colorG[i] = initialColor.y + (finalColor.y - initialColor.y) * t;
+          s.m_colorB[i] = initialColor.z + (finalColor.z - initialColor.z) * t;
+          s.m_colorA[i] = initialColor.w + (finalColor.w - initialColor.w) * t;
+        }
+
+        if (t_features & ParticleKernels::uf_scales)
+        {
+          float initialScale = s.m_randomScale[i * 2];
+          float finalScale = s.m_randomScale[i * 2 + 1];
+          s.m_scale[i] = initialScale + (finalScale - initialScale) * t;
+        }
+      }
+
+        // an Euler step, or a velocity Verlet step for the fixed step
+      s.m_oldPositionX[i] = s.m_positionX[i];
+      s.m_oldPositionY[i] = s.m_positionY[i];
+
+      if (t_features & ParticleKernels::uf_fixedStep)
+      {
+        float velocityX = s.m_velocityX[i] + s.m_forceX[i];
+        float velocityY = s.m_velocityY[i] + s.m_forceY[i];
+        s.m_positionX[i] += (velocityX + forceX * 0.5f) * dt;
+        s.m_positionY[i] += (velocityY + forceY * 0.5f) * dt;
+        s.m_velocityX[i] = velocityX + forceX;
+        s.m_velocityY[i] = velocityY + forceY;
+      }
+      else
+      {
+        s.m_velocityX[i] += forceX + s.m_forceX[i];
+        s.m_velocityY[i] += forceY + s.m_forceY[i];
+        s.m_positionX[i] += s.m_velocityX[i] * dt;
+        s.m_positionY[i] += s.m_velocityY[i] * dt;
+      }
+
+      if ((t_features & ParticleKernels::uf_spinning) && (t_features & ParticleKernels::uf_facing))
+      {
+        if (s.m_angularVelocity[i])
+          s.m_rotation[i] += s.m_angularVelocity[i] * dt;
+        else
+          s.m_rotation[i] = atan2f(s.m_velocityY[i], s.m_velocityX[i]);
+      }
+      else if (t_features & ParticleKernels::uf_spinning)
+        s.m_rotation[i] += s.m_angularVelocity[i] * dt;
+      else if (t_features & ParticleKernels::uf_facing)
+        s.m_rotation[i] = atan2f(s.m_velocityY[i], s.m_velocityX[i]);
+
+      s.m_forceX[i] = 0.0f;
+      s.m_forceY[i] = 0.0f;
+    }
+  }
+
+  /*!***********************************************************************************
+  \brief  the columns moved on by pOffset particles, for the scalar tail of a SIMD kernel
+  *************************************************************************************/
+  ParticleKernels::evaluatedColumns AdvanceColumns(const ParticleKernels::evaluatedColumns& pColumns, unsigned pOffset)
+  {
+    ParticleKernels::evaluatedColumns columns = { pColumns.m_positionX + pOffset, pColumns.m_positionY + pOffset, pColumns.m_rotation + pOffset,
+                                                  pColumns.m_scale + pOffset, pColumns.m_colorR + pOffset, pColumns.m_colorG + pOffset,
+                                                  pColumns.m_colorB + pOffset, pColumns.m_colorA + pOffset };
+    return columns;
+  }
+
+  void EvaluateParticlesScalar(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::evaluateParameters& pParameters, const ParticleKernels::evaluatedColumns& c)
+  {
+    const vector4& acceleration = pParameters.m_acceleration;
+    const vector4& initialColor = pParameters.m_initialColor;
+    const vector4& finalColor = pParameters.m_finalColor;
+
+    for (unsigned i = pBegin; i < pEnd; ++i)
+    {
+      unsigned column = i - pBegin;
+      float age = s.m_currentLifetime[i] + pParameters.m_timeOffset;
+      age = (age > 0.0f) ? age : 0.0f;
+      float t = age / s.m_totalLifetime[i];
+
+        // the integrator adds half the acceleration times dt to the velocity every frame,
+        // so the velocity grows with a / 2 and the position with a / 4 * t^2
+      float velocityX = s.m_velocityX[i] + acceleration.x * (age / 2.0f);
+      float velocityY = s.m_velocityY[i] + acceleration.y * (age / 2.0f);
+      float angularVelocity = s.m_angularVelocity[i];
+      float rotation = s.m_rotation[i] + angularVelocity * age;
+
+      c.m_positionX[column] = s.m_positionX[i] + s.m_velocityX[i] * age + acceleration.x * (age * age / 4.0f);
+      c.m_positionY[column] = s.m_positionY[i] + s.m_velocityY[i] * age + acceleration.y * (age * age / 4.0f);
+      c.m_rotation[column] = angularVelocity ? rotation : atan2f(velocityY, velocityX);
+
+      float initialScale = s.m_randomScale[i * 2];
+      float finalScale = s.m_randomScale[i * 2 + 1];
+      c.m_scale[column] = initialScale + (finalScale - initialScale) * t;
+
+      c.m_colorR[column] = initialColor.x + (finalColor.x - initialColor.x) * t;
+      c.m_colorG[column] = initialColor.y + (finalColor.y - initialColor.y) * t;
+      c.m_colorB[column] = initialColor.z + (finalColor.z - initialColor.z) * t;
+      c.m_colorA[column] = initialColor.w + (finalColor.w - initialColor.w) * t;
+    }
+  }
+
+  unsigned MarkDeadParticlesScalar(kernelStreams& s, unsigned pBegin, unsigned pEnd)
+  {
+    unsigned deathCount = 0;
+
+    for (unsigned i = pBegin; i < pEnd; ++i)
+    {
+      if (s.m_currentLifetime[i] > s.m_totalLifetime[i])
+      {
+        s.m_isActive[i] = false;
+        ++deathCount;
+      }
+    }
+
+    return deathCount;
+  }
+
+  unsigned FindParticlesInPolygonScalar(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::polygonPlanes& pPolygon, unsigned* pInside)
+  {
+    unsigned insideCount = 0;
+
+    for (unsigned i = pBegin; i < pEnd; ++i)
+    {
+      float x = s.m_positionX[i];
+      float y = s.m_positionY[i];
+
+      bool isOutside = (x < pPolygon.m_minX) || (x > pPolygon.m_maxX) || (y < pPolygon.m_minY) || (y > pPolygon.m_maxY);
+      for (unsigned plane = 0; !isOutside && (plane < pPolygon.m_planeCount); ++plane)
+      {
+        const float* halfPlane = pPolygon.m_planes + plane * 3;
+        isOutside = (halfPlane[0] * x + halfPlane[1] * y - halfPlane[2]) > 0.0f;
+      }
+
+      if (!isOutside)
+        pInside[insideCount++] = i;
+    }
+
+    return insideCount;
+  }
+
+  unsigned FindParticlesInCircleScalar(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::circleShape& pCircle, unsigned* pInside)
+  {
+    float radiusSquared = pCircle.m_radius * pCircle.m_radius;
+    unsigned insideCount = 0;
+
+    for (unsigned i = pBegin; i < pEnd; ++i)
+    {
+      float offsetX = s.m_positionX[i] - pCircle.m_centerX;
+      float offsetY = s.m_positionY[i] - pCircle.m_centerY;
+
+        // always writing the index, it's only kept if the particle is inside
+      pInside[insideCount] = i;
+      insideCount += (offsetX * offsetX + offsetY * offsetY <= radiusSquared) ? 1 : 0;
+    }
+
+    return insideCount;
+  }
+
+  void ComputeBoundsScalar(kernelStreams& s, unsigned pBegin, unsigned pEnd, float pBounds[4])
+  {
+    for (unsigned i = pBegin; i < pEnd; ++i)
+    {
+      pBounds[0] = (s.m_positionX[i] < pBounds[0]) ? s.m_positionX[i] : pBounds[0];
+      pBounds[1] = (s.m_positionY[i] < pBounds[1]) ? s.m_positionY[i] : pBounds[1];
+      pBounds[2] = (s.m_positionX[i] > pBounds[2]) ? s.m_positionX[i] : pBounds[2];
+      pBounds[3] = (s.m_positionY[i] > pBounds[3]) ? s.m_positionY[i] : pBounds[3];
+    }
+  }
+
+    // first inactive particle in [pBegin, pEnd) (pEnd if there's none)
+  unsigned FindInactiveScalar(const unsigned char* pIsActive, unsigned pBegin, unsigned pEnd)
+  {
+    for (unsigned i = pBegin; i < pEnd; ++i)
+    {
+      if (!pIsActive[i])
+        return i;
+    }
+
+    return pEnd;
+  }
+
+    // one past the last active particle in [pBegin, pEnd) (pBegin if there's none)
+  unsigned FindLastActiveScalar(const unsigned char* pIsActive, unsigned pBegin, unsigned pEnd)
+  {
+    for (unsigned i = pEnd; i > pBegin; --i)
+    {
+      if (pIsActive[i - 1])
+        return i;
+    }
+
+    return pBegin;
+  }
+
+  const float c_pi = 3.14159265f;
+  const float c_inverseTwoPi = 0.159154943f;
+  const float c_wholeFloat = 8388608.0f; //!< floats this big (2^23) don't have a fraction
+
+    // bits of the floats the half float conversion works with
+  const std::uint32_t c_halfOverflow = (127 + 16) << 23;                      //!< smallest float that's infinity as a half
+  const std::uint32_t c_floatInfinity = 255 << 23;                            //!< float infinity
+  const std::uint32_t c_halfNormal = 113 << 23;                               //!< smallest float that's a normal half
+  const std::uint32_t c_halfDenormalMagic = ((127 - 15) + (23 - 10) + 1) << 23; //!< shifts denormal halves into the low bits
+  const std::uint32_t c_halfRebias = 0xC8000FFFu;                             //!< (15 - 127) << 23 plus rounding (wraps around)
+
+  std::uint32_t FloatBits(float pValue)
+  {
+    std::uint32_t bits;
+    std::memcpy(&bits, &pValue, sizeof(bits));
+    return bits;
+  }
+
+  float BitsFloat(std::uint32_t pBits)
+  {
+    float value;
+    std::memcpy(&value, &pBits, sizeof(value));
+    return value;
+  }
+
+    // float to half float, rounding to nearest even
+  std::uint16_t FloatToHalf(float pValue)
+  {
+    std::uint32_t bits = FloatBits(pValue);
+    std::uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    std::uint32_t half;
+    if (bits >= c_halfOverflow)
+      half = (bits > c_floatInfinity) ? 0x7E00 : 0x7C00;
+    else if (bits < c_halfNormal)
+      half = FloatBits(BitsFloat(bits) + BitsFloat(c_halfDenormalMagic)) - c_halfDenormalMagic;
+    else
+      half = (bits + c_halfRebias + ((bits >> 13) & 1)) >> 13;
+
+    return static_cast<std::uint16_t>(half | (sign >> 16));
+  }
+
+    // color channel in [0, 1] to 8 bits (NaN becomes 0)
+  std::uint32_t ColorToByte(float pValue)
+  {
+    pValue = (pValue > 0.0f) ? pValue : 0.0f;
+    pValue = (pValue < 1.0f) ? pValue : 1.0f;
+    return static_cast<std::uint32_t>(pValue * 255.0f + 0.5f);
+  }
+
+    // angle to [-pi, pi), so spinning particles don't run out of half float precision
+    // (the rotation keeps adding up in the storage). Every instruction set does the same
+    // operations so they give the same bits
+  float WrapAngle(float pAngle)
+  {
+    float turns = floorf((pAngle + c_pi) * c_inverseTwoPi);
+    return pAngle - turns * (2.0f * c_pi);
+  }
+
+  void PackParticlesScalar(const ParticleKernels::packSource& s, unsigned pBegin, unsigned pEnd, ParticleKernels::packedParticle* pPacked)
+  {
+    for (unsigned i = pBegin; i < pEnd; ++i)
+    {
+      ParticleKernels::packedParticle& packed = pPacked[i];
+      packed.m_position[0] = FloatToHalf(s.m_positionX[i] - s.m_originX);
+      packed.m_position[1] = FloatToHalf(s.m_positionY[i] - s.m_originY);
+      packed.m_position[2] = FloatToHalf(s.m_positionZ[i] - s.m_originZ);
+      packed.m_rotation = FloatToHalf(WrapAngle(s.m_rotation[i]));
+      packed.m_scale = FloatToHalf(s.m_scale[i]);
+      packed.m_padding = 0;
+      packed.m_color = ColorToByte(s.m_colorR[i]) | (ColorToByte(s.m_colorG[i]) << 8) | (ColorToByte(s.m_colorB[i]) << 16) | (ColorToByte(s.m_colorA[i]) << 24);
+    }
+  }
+
+#ifdef PARTICLE_KERNELS_X86
+    // coefficients of the polynomial approximating atan on [0, 1] (error below 1e-6 radians)
+  const float c_atanCoefficients[6] = { 0.99997726f, -0.33262347f, 0.19354346f, -0.11643287f, 0.05265332f, -0.01172120f };
+
+  /////////////////////////////////////////////////////////////////////////////////////
+  // SSE2 kernels
+  /////////////////////////////////////////////////////////////////////////////////////
+
+  __m128 Atan2SSE2(__m128 y, __m128 x)
+  {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 absX = _mm_andnot_ps(signMask, x);
+    __m128 absY = _mm_andnot_ps(signMask, y);
+
+      // atan of the smaller over the bigger component, so the ratio stays in [0, 1]
+    __m128 maxComponent = _mm_max_ps(absX, absY);
+    __m128 minComponent = _mm_min_ps(absX, absY);
+    __m128 ratio = _mm_div_ps(minComponent, _mm_max_ps(maxComponent, _mm_set1_ps(1e-30f)));
+    __m128 ratioSquared = _mm_mul_ps(ratio, ratio);
+
+    __m128 result = _mm_set1_ps(c_atanCoefficients[5]);
+    for (int i = 4; i >= 0; --i)
+      result = _mm_add_ps(_mm_mul_ps(result, ratioSquared), _mm_set1_ps(c_atanCoefficients[i]));
+    result = _mm_mul_ps(result, ratio);
+
+      // moving the result into the right octant and quadrant
+    __m128 swapped = _mm_cmpgt_ps(absY, absX);
+    result = _mm_or_ps(_mm_and_ps(swapped, _mm_sub_ps(_mm_set1_ps(c_pi / 2.0f), result)), _mm_andnot_ps(swapped, result));
+    __m128 negativeX = _mm_cmplt_ps(x, _mm_setzero_ps());
+    result = _mm_or_ps(_mm_and_ps(negativeX, _mm_sub_ps(_mm_set1_ps(c_pi), result)), _mm_andnot_ps(negativeX, result));
+    return _mm_xor_ps(result, _mm_and_ps(signMask, y));
+  }
+
+  void UpdateLifetimesSSE2(kernelStreams& s, unsigned pBegin, unsigned pEnd, float dt)
+  {
+    const __m128 timeStep = _mm_set1_ps(dt);
+
+    unsigned i = pBegin;
+    for (; i + 4 <= pEnd; i += 4)
+      _mm_storeu_ps(s.m_currentLifetime + i, _mm_add_ps(_mm_loadu_ps(s.m_currentLifetime + i), timeStep));
+
+    UpdateLifetimesScalar(s, i, pEnd, dt);
+  }
+
+  template <unsigned t_features>
+  void UpdateParticlesSSE2(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::updateParameters& pParameters)
+  {
+    const vector4& initialColor = pParameters.m_initialColor;
+    const vector4& finalColor = pParameters.m_finalColor;
+    const __m128 initialR = _mm_set1_ps(initialColor.x), deltaR = _mm_set1_ps(finalColor.x - initialColor.x);
+    const __m128 initialG = _mm_set1_ps(initialColor.y), deltaG = _mm_set1_ps(finalColor.y - initialColor.y);
+    const __m128 initialB = _mm_set1_ps(initialColor.z), deltaB = _mm_set1_ps(finalColor.z - initialColor.z);
+    const __m128 initialA = _mm_set1_ps(initialColor.w), deltaA = _mm_set1_ps(finalColor.w - initialColor.w);
+
+    float dt = pParameters.m_dt;
+    const __m128 forceX = _mm_set1_ps(pParameters.m_accumulatedForce.x * (dt / 2.0f));
+    const __m128 forceY = _mm_set1_ps(pParameters.m_accumulatedForce.y * (dt / 2.0f));
+    const __m128 halfForceX = _mm_mul_ps(forceX, _mm_set1_ps(0.5f));
+    const __m128 halfForceY = _mm_mul_ps(forceY, _mm_set1_ps(0.5f));
+    const __m128 timeStep = _mm_set1_ps(dt);
+    const __m128 zero = _mm_setzero_ps();
+
+    unsigned i = pBegin;
+    for (; i + 4 <= pEnd; i += 4)
+    {
+      __m128 lifetime = _mm_add_ps(_mm_loadu_ps(s.m_currentLifetime + i), timeStep);
+      _mm_storeu_ps(s.m_currentLifetime + i, lifetime);
+
+      if (t_features & (ParticleKernels::uf_colors | ParticleKernels::uf_scales))
+      {
+        __m128 t = _mm_div_ps(lifetime, _mm_loadu_ps(s.m_totalLifetime + i));
+
+        if (t_features & ParticleKernels::uf_colors)
+        {
+          _mm_storeu_ps(s.m_colorR + i, _mm_add_ps(initialR, _mm_mul_ps(deltaR, t)));
+          _mm_storeu_ps(s.m_colorG + i, _mm_add_ps(initialG, _mm_mul_ps(deltaG, t)));
+          _mm_storeu_ps(s.m_colorB + i, _mm_add_ps(initialB, _mm_mul_ps(deltaB, t)));
+          _mm_storeu_ps(s.m_colorA + i, _mm_add_ps(initialA, _mm_mul_ps(deltaA, t)));
+        }
+
+        if (t_features & ParticleKernels::uf_scales)
+        {
+          __m128 pairs0 = _mm_loadu_ps(s.m_randomScale + i * 2);
+          __m128 pairs1 = _mm_loadu_ps(s.m_randomScale + i * 2 + 4);
+          __m128 initialScale = _mm_shuffle_ps(pairs0, pairs1, _MM_SHUFFLE(2, 0, 2, 0));
+          __m128 finalScale = _mm_shuffle_ps(pairs0, pairs1, _MM_SHUFFLE(3, 1, 3, 1));
+          _mm_storeu_ps(s.m_scale + i, _mm_add_ps(initialScale, _mm_mul_ps(_mm_sub_ps(finalScale, initialScale), t)));
+        }
+      }
+
+      __m128 positionX = _mm_loadu_ps(s.m_positionX + i);
+      __m128 positionY = _mm_loadu_ps(s.m_positionY + i);
+      _mm_storeu_ps(s.m_oldPositionX + i, positionX);
+      _mm_storeu_ps(s.m_oldPositionY + i, positionY);
+
+      __m128 velocityX, velocityY;
+      if (t_features & ParticleKernels::uf_fixedStep)
+      {
+        velocityX = _mm_add_ps(_mm_loadu_ps(s.m_velocityX + i), _mm_loadu_ps(s.m_forceX + i));
+        velocityY = _mm_add_ps(_mm_loadu_ps(s.m_velocityY + i), _mm_loadu_ps(s.m_forceY + i));
+        _mm_storeu_ps(s.m_positionX + i, _mm_add_ps(positionX, _mm_mul_ps(_mm_add_ps(velocityX, halfForceX), timeStep)));
+        _mm_storeu_ps(s.m_positionY + i, _mm_add_ps(positionY, _mm_mul_ps(_mm_add_ps(velocityY, halfForceY), timeStep)));
+        velocityX = _mm_add_ps(velocityX, forceX);
+        velocityY = _mm_add_ps(velocityY, forceY);
+      }
+      else
+      {
+        velocityX = _mm_add_ps(_mm_loadu_ps(s.m_velocityX + i), _mm_add_ps(forceX, _mm_loadu_ps(s.m_forceX + i)));
+        velocityY = _mm_add_ps(_mm_loadu_ps(s.m_velocityY + i), _mm_add_ps(forceY, _mm_loadu_ps(s.m_forceY + i)));
+        _mm_storeu_ps(s.m_positionX + i, _mm_add_ps(positionX, _mm_mul_ps(velocityX, timeStep)));
+        _mm_storeu_ps(s.m_positionY + i, _mm_add_ps(positionY, _mm_mul_ps(velocityY, timeStep)));
+      }
+      _mm_storeu_ps(s.m_velocityX + i, velocityX);
+      _mm_storeu_ps(s.m_velocityY + i, velocityY);
+
+      if (t_features & ParticleKernels::uf_spinning)
+      {
+        __m128 angularVelocity = _mm_loadu_ps(s.m_angularVelocity + i);
+        __m128 spinning = _mm_add_ps(_mm_loadu_ps(s.m_rotation + i), _mm_mul_ps(angularVelocity, timeStep));
+
+        if (t_features & ParticleKernels::uf_facing)
+        {
+          __m128 isFacing = _mm_cmpeq_ps(angularVelocity, zero);
+          spinning = _mm_or_ps(_mm_and_ps(isFacing, Atan2SSE2(velocityY, velocityX)), _mm_andnot_ps(isFacing, spinning));
+        }
+        _mm_storeu_ps(s.m_rotation + i, spinning);
+      }
+      else if (t_features & ParticleKernels::uf_facing)
+        _mm_storeu_ps(s.m_rotation + i, Atan2SSE2(velocityY, velocityX));
+
+      _mm_storeu_ps(s.m_forceX + i, zero);
+      _mm_storeu_ps(s.m_forceY + i, zero);
+    }
+
+    UpdateParticlesScalar<t_features>(s, i, pEnd, pParameters);
+  }
+
+  void EvaluateParticlesSSE2(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::evaluateParameters& pParameters, const ParticleKernels::evaluatedColumns& c)
+  {
+    const vector4& initialColor = pParameters.m_initialColor;
+    const vector4& finalColor = pParameters.m_finalColor;
+    const __m128 initialR = _mm_set1_ps(initialColor.x), deltaR = _mm_set1_ps(finalColor.x - initialColor.x);
+    const __m128 initialG = _mm_set1_ps(initialColor.y), deltaG = _mm_set1_ps(finalColor.y - initialColor.y);
+    const __m128 initialB = _mm_set1_ps(initialColor.z), deltaB = _mm_set1_ps(finalColor.z - initialColor.z);
+    const __m128 initialA = _mm_set1_ps(initialColor.w), deltaA = _mm_set1_ps(finalColor.w - initialColor.w);
+
+    const __m128 accelerationX = _mm_set1_ps(pParameters.m_acceleration.x);
+    const __m128 accelerationY = _mm_set1_ps(pParameters.m_acceleration.y);
+    const __m128 timeOffset = _mm_set1_ps(pParameters.m_timeOffset);
+    const __m128 half = _mm_set1_ps(0.5f), quarter = _mm_set1_ps(0.25f);
+    const __m128 zero = _mm_setzero_ps();
+
+    unsigned i = pBegin;
+    for (; i + 4 <= pEnd; i += 4)
+    {
+      unsigned column = i - pBegin;
+      __m128 age = _mm_max_ps(_mm_add_ps(_mm_loadu_ps(s.m_currentLifetime + i), timeOffset), zero);
+      __m128 t = _mm_div_ps(age, _mm_loadu_ps(s.m_totalLifetime + i));
+      __m128 halfAge = _mm_mul_ps(age, half);
+      __m128 quarterAgeSquared = _mm_mul_ps(_mm_mul_ps(age, age), quarter);
+
+        // same closed form as the scalar kernel
+      __m128 spawnVelocityX = _mm_loadu_ps(s.m_velocityX + i);
+      __m128 spawnVelocityY = _mm_loadu_ps(s.m_velocityY + i);
+      __m128 velocityX = _mm_add_ps(spawnVelocityX, _mm_mul_ps(accelerationX, halfAge));
+      __m128 velocityY = _mm_add_ps(spawnVelocityY, _mm_mul_ps(accelerationY, halfAge));
+      __m128 positionX = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(s.m_positionX + i), _mm_mul_ps(spawnVelocityX, age)), _mm_mul_ps(accelerationX, quarterAgeSquared));
+      __m128 positionY = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(s.m_positionY + i), _mm_mul_ps(spawnVelocityY, age)), _mm_mul_ps(accelerationY, quarterAgeSquared));
+
+      __m128 angularVelocity = _mm_loadu_ps(s.m_angularVelocity + i);
+      __m128 spinning = _mm_add_ps(_mm_loadu_ps(s.m_rotation + i), _mm_mul_ps(angularVelocity, age));
+      __m128 isFacing = _mm_cmpeq_ps(angularVelocity, zero);
+      __m128 rotation = spinning;
+
+        // the atan is only worked out if a particle needs it, most emitters spin all of theirs
+      if (_mm_movemask_ps(isFacing))
+        rotation = _mm_or_ps(_mm_and_ps(isFacing, Atan2SSE2(velocityY, velocityX)), _mm_andnot_ps(isFacing, spinning));
+
+      __m128 pairs0 = _mm_loadu_ps(s.m_randomScale + i * 2);
+      __m128 pairs1 = _mm_loadu_ps(s.m_randomScale + i * 2 + 4);
+      __m128 initialScale = _mm_shuffle_ps(pairs0, pairs1, _MM_SHUFFLE(2, 0, 2, 0));
+      __m128 finalScale = _mm_shuffle_ps(pairs0, pairs1, _MM_SHUFFLE(3, 1, 3, 1));
+
+        // only written once everything is read, so the particles can be evaluated in place
+      _mm_storeu_ps(c.m_positionX + column, positionX);
+      _mm_storeu_ps(c.m_positionY + column, positionY);
+      _mm_storeu_ps(c.m_rotation + column, rotation);
+      _mm_storeu_ps(c.m_scale + column, _mm_add_ps(initialScale, _mm_mul_ps(_mm_sub_ps(finalScale, initialScale), t)));
+      _mm_storeu_ps(c.m_colorR + column, _mm_add_ps(initialR, _mm_mul_ps(deltaR, t)));
+      _mm_storeu_ps(c.m_colorG + column, _mm_add_ps(initialG, _mm_mul_ps(deltaG, t)));
+      _mm_storeu_ps(c.m_colorB + column, _mm_add_ps(initialB, _mm_mul_ps(deltaB, t)));
+      _mm_storeu_ps(c.m_colorA + column, _mm_add_ps(initialA, _mm_mul_ps(deltaA, t)));
+    }
+
+    EvaluateParticlesScalar(s, i, pEnd, pParameters, AdvanceColumns(c, i - pBegin));
+  }
+
+  unsigned MarkDeadParticlesSSE2(kernelStreams& s, unsigned pBegin, unsigned pEnd)
+  {
+    unsigned deathCount = 0;
+
+    unsigned i = pBegin;
+    for (; i + 4 <= pEnd; i += 4)
+    {
+      unsigned deadMask = _mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(s.m_currentLifetime + i), _mm_loadu_ps(s.m_totalLifetime + i)));
+      for (; deadMask; deadMask &= deadMask - 1)
+      {
+        s.m_isActive[i + LowestBit(deadMask)] = false;
+        ++deathCount;
+      }
+    }
+
+    return deathCount + MarkDeadParticlesScalar(s, i, pEnd);
+  }
+
+  unsigned FindParticlesInPolygonSSE2(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::polygonPlanes& pPolygon, unsigned* pInside)
+  {
+    const __m128 minX = _mm_set1_ps(pPolygon.m_minX);
+    const __m128 minY = _mm_set1_ps(pPolygon.m_minY);
+    const __m128 maxX = _mm_set1_ps(pPolygon.m_maxX);
+    const __m128 maxY = _mm_set1_ps(pPolygon.m_maxY);
+    const __m128 zero = _mm_setzero_ps();
+
+    unsigned insideCount = 0;
+
+    unsigned i = pBegin;
+    for (; i + 4 <= pEnd; i += 4)
+    {
+      __m128 x = _mm_loadu_ps(s.m_positionX + i);
+      __m128 y = _mm_loadu_ps(s.m_positionY + i);
+
+        // the faces are only checked while some of the batch could still be inside
+      __m128 outside = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(x, minX), _mm_cmpgt_ps(x, maxX)), _mm_or_ps(_mm_cmplt_ps(y, minY), _mm_cmpgt_ps(y, maxY)));
+      for (unsigned plane = 0; (plane < pPolygon.m_planeCount) && (_mm_movemask_ps(outside) != 0xF); ++plane)
+      {
+        const float* halfPlane = pPolygon.m_planes + plane * 3;
+        __m128 distance = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(halfPlane[0]), x), _mm_mul_ps(_mm_set1_ps(halfPlane[1]), y)), _mm_set1_ps(halfPlane[2]));
+        outside = _mm_or_ps(outside, _mm_cmpgt_ps(distance, zero));
+      }
+
+      for (unsigned insideMask = _mm_movemask_ps(outside) ^ 0xF; insideMask; insideMask &= insideMask - 1)
+        pInside[insideCount++] = i + LowestBit(insideMask);
+    }
+
+    return insideCount + FindParticlesInPolygonScalar(s, i, pEnd, pPolygon, pInside + insideCount);
+  }
+
+  unsigned FindParticlesInCircleSSE2(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::circleShape& pCircle, unsigned* pInside)
+  {
+    const __m128 centerX = _mm_set1_ps(pCircle.m_centerX);
+    const __m128 centerY = _mm_set1_ps(pCircle.m_centerY);
+    const __m128 radiusSquared = _mm_set1_ps(pCircle.m_radius * pCircle.m_radius);
+
+    unsigned insideCount = 0;
+
+    unsigned i = pBegin;
+    for (; i + 4 <= pEnd; i += 4)
+    {
+      __m128 offsetX = _mm_sub_ps(_mm_loadu_ps(s.m_positionX + i), centerX);
+      __m128 offsetY = _mm_sub_ps(_mm_loadu_ps(s.m_positionY + i), centerY);
+      __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(offsetX, offsetX), _mm_mul_ps(offsetY, offsetY));
+
+      for (unsigned insideMask = _mm_movemask_ps(_mm_cmple_ps(distanceSquared, radiusSquared)); insideMask; insideMask &= insideMask - 1)
+        pInside[insideCount++] = i + LowestBit(insideMask);
+    }
+
+    return insideCount + FindParticlesInCircleScalar(s, i, pEnd, pCircle, pInside + insideCount);
+  }
+
+  void ComputeBoundsSSE2(kernelStreams& s, unsigned pBegin, unsigned pEnd, float pBounds[4])
+  {
+    __m128 minX = _mm_set1_ps(pBounds[0]);
+    __m128 minY = _mm_set1_ps(pBounds[1]);
+    __m128 maxX = _mm_set1_ps(pBounds[2]);
+    __m128 maxY = _mm_set1_ps(pBounds[3]);
+
+    unsigned i = pBegin;
+    for (; i + 4 <= pEnd; i += 4)
+    {
+      __m128 x = _mm_loadu_ps(s.m_positionX + i);
+      __m128 y = _mm_loadu_ps(s.m_positionY + i);
+      minX = _mm_min_ps(minX, x);
+      minY = _mm_min_ps(minY, y);
+      maxX = _mm_max_ps(maxX, x);
+      maxY = _mm_max_ps(maxY, y);
+    }
+
+      // folding the lanes together
+    float lanes[4][4];
+    _mm_storeu_ps(lanes[0], minX);
+    _mm_storeu_ps(lanes[1], minY);
+    _mm_storeu_ps(lanes[2], maxX);
+    _mm_storeu_ps(lanes[3], maxY);
+
+    for (unsigned lane = 0; lane < 4; ++lane)
+    {
+      pBounds[0] = (lanes[0][lane] < pBounds[0]) ? lanes[0][lane] : pBounds[0];
+      pBounds[1] = (lanes[1][lane] < pBounds[1]) ? lanes[1][lane] : pBounds[1];
+      pBounds[2] = (lanes[2][lane] > pBounds[2]) ? lanes[2][lane] : pBounds[2];
+      pBounds[3] = (lanes[3][lane] > pBounds[3]) ? lanes[3][lane] : pBounds[3];
+    }
+
+    ComputeBoundsScalar(s, i, pEnd, pBounds);
+  }
+
+    // same as FindInactiveScalar, checking 16 particles at a time
+  unsigned FindInactiveSSE2(const unsigned char* pIsActive, unsigned pBegin, unsigned pEnd)
+  {
+    const __m128i zero = _mm_setzero_si128();
+
+    unsigned i = pBegin;
+    for (; i + 16 <= pEnd; i += 16)
+    {
+      unsigned inactiveMask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIsActive + i)), zero));
+      if (inactiveMask)
+        return i + LowestBit(inactiveMask);
+    }
+
+    return FindInactiveScalar(pIsActive, i, pEnd);
+  }
+
+    // same as FindLastActiveScalar, checking 16 particles at a time
+  unsigned FindLastActiveSSE2(const unsigned char* pIsActive, unsigned pBegin, unsigned pEnd)
+  {
+    const __m128i zero = _mm_setzero_si128();
+
+    unsigned i = pEnd;
+    for (; i >= pBegin + 16; i -= 16)
+    {
+      unsigned activeMask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIsActive + i - 16)), zero)) ^ 0xFFFF;
+      if (activeMask)
+        return i - 16 + HighestBit(activeMask) + 1;
+    }
+
+    return FindLastActiveScalar(pIsActive, pBegin, i);
+  }
+
+    // same as FloatToHalf, 4 at a time (the half floats are in the low 16 bits of a lane)
+  __m128i FloatToHalfSSE2(__m128 pValues)
+  {
+    __m128i bits = _mm_castps_si128(pValues);
+    __m128i sign = _mm_and_si128(bits, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+    bits = _mm_xor_si128(bits, sign);
+
+      // the bits without the sign are positive, so signed compares work
+    __m128i isOverflow = _mm_cmpgt_epi32(bits, _mm_set1_epi32(c_halfOverflow - 1));
+    __m128i isNaN = _mm_cmpgt_epi32(bits, _mm_set1_epi32(c_floatInfinity));
+    __m128i isDenormal = _mm_cmplt_epi32(bits, _mm_set1_epi32(c_halfNormal));
+
+    __m128i overflow = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(isNaN, _mm_set1_epi32(0x0200)));
+    __m128 denormalMagic = _mm_castsi128_ps(_mm_set1_epi32(c_halfDenormalMagic));
+    __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(bits), denormalMagic)), _mm_castps_si128(denormalMagic));
+    __m128i roundOdd = _mm_and_si128(_mm_srli_epi32(bits, 13), _mm_set1_epi32(1));
+    __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(bits, _mm_set1_epi32(static_cast<int>(c_halfRebias))), roundOdd), 13);
+
+    __m128i half = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+    half = _mm_or_si128(_mm_and_si128(isOverflow, overflow), _mm_andnot_si128(isOverflow, half));
+    return _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+  }
+
+    // same as WrapAngle, 4 at a time (SSE2 can't round down, so truncated turns that went
+    // up are taken down by one, and turns too big to have a fraction are kept)
+  __m128 WrapAngleSSE2(__m128 pAngles)
+  {
+    __m128 turns = _mm_mul_ps(_mm_add_ps(pAngles, _mm_set1_ps(c_pi)), _mm_set1_ps(c_inverseTwoPi));
+    __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(turns));
+    truncated = _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, turns), _mm_set1_ps(1.0f)));
+
+    __m128 hasFraction = _mm_cmplt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), turns), _mm_set1_ps(c_wholeFloat));
+    turns = _mm_or_ps(_mm_and_ps(hasFraction, truncated), _mm_andnot_ps(hasFraction, turns));
+    return _mm_sub_ps(pAngles, _mm_mul_ps(turns, _mm_set1_ps(2.0f * c_pi)));
+  }
+
+    // same as ColorToByte, 4 at a time
+  __m128i ColorToByteSSE2(__m128 pValues)
+  {
+    pValues = _mm_min_ps(_mm_max_ps(pValues, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(pValues, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+  }
+
+    // turns 4 lanes of every word of a packed particle into 4 packed particles
+  void StorePackedSSE2(__m128i pWord0, __m128i pWord1, __m128i pWord2, __m128i pWord3, ParticleKernels::packedParticle* pPacked)
+  {
+    __m128i low01 = _mm_unpacklo_epi32(pWord0, pWord1);
+    __m128i high01 = _mm_unpackhi_epi32(pWord0, pWord1);
+    __m128i low23 = _mm_unpacklo_epi32(pWord2, pWord3);
+    __m128i high23 = _mm_unpackhi_epi32(pWord2, pWord3);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pPacked), _mm_unpacklo_epi64(low01, low23));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pPacked + 1), _mm_unpackhi_epi64(low01, low23));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pPacked + 2), _mm_unpacklo_epi64(high01, high23));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pPacked + 3), _mm_unpackhi_epi64(high01, high23));
+  }
+
+  void PackParticlesSSE2(const ParticleKernels::packSource& s, unsigned pBegin, unsigned pEnd, ParticleKernels::packedParticle* pPacked)
+  {
+    __m128 originX = _mm_set1_ps(s.m_originX);
+    __m128 originY = _mm_set1_ps(s.m_originY);
+    __m128 originZ = _mm_set1_ps(s.m_originZ);
+
+    unsigned i = pBegin;
+    for (; i + 4 <= pEnd; i += 4)
+    {
+      __m128i x = FloatToHalfSSE2(_mm_sub_ps(_mm_loadu_ps(s.m_positionX + i), originX));
+      __m128i y = FloatToHalfSSE2(_mm_sub_ps(_mm_loadu_ps(s.m_positionY + i), originY));
+      __m128i z = FloatToHalfSSE2(_mm_sub_ps(_mm_loadu_ps(s.m_positionZ + i), originZ));
+      __m128i rotation = FloatToHalfSSE2(WrapAngleSSE2(_mm_loadu_ps(s.m_rotation + i)));
+      __m128i scale = FloatToHalfSSE2(_mm_loadu_ps(s.m_scale + i));
+
+      __m128i color = ColorToByteSSE2(_mm_loadu_ps(s.m_colorR + i));
+      color = _mm_or_si128(color, _mm_slli_epi32(ColorToByteSSE2(_mm_loadu_ps(s.m_colorG + i)), 8));
+      color = _mm_or_si128(color, _mm_slli_epi32(ColorToByteSSE2(_mm_loadu_ps(s.m_colorB + i)), 16));
+      color = _mm_or_si128(color, _mm_slli_epi32(ColorToByteSSE2(_mm_loadu_ps(s.m_colorA + i)), 24));
+
+      StorePackedSSE2(_mm_or_si128(x, _mm_slli_epi32(y, 16)), _mm_or_si128(z, _mm_slli_epi32(rotation, 16)), scale, color, pPacked + i);
+    }
+
+    PackParticlesScalar(s, i, pEnd, pPacked);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////////////
+  // AVX2 kernels
+  /////////////////////////////////////////////////////////////////////////////////////
+
+  PARTICLE_TARGET_AVX2 __m256 Atan2AVX2(__m256 y, __m256 x)
+  {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 absX = _mm256_andnot_ps(signMask, x);
+    __m256 absY = _mm256_andnot_ps(signMask, y);
+
+      // atan of the smaller over the bigger component, so the ratio stays in [0, 1]
+    __m256 maxComponent = _mm256_max_ps(absX, absY);
+    __m256 minComponent = _mm256_min_ps(absX, absY);
+    __m256 ratio = _mm256_div_ps(minComponent, _mm256_max_ps(maxComponent, _mm256_set1_ps(1e-30f)));
+    __m256 ratioSquared = _mm256_mul_ps(ratio, ratio);
+
+    __m256 result = _mm256_set1_ps(c_atanCoefficients[5]);
+    for (int i = 4; i >= 0; --i)
+      result = _mm256_add_ps(_mm256_mul_ps(result, ratioSquared), _mm256_set1_ps(c_atanCoefficients[i]));
+    result = _mm256_mul_ps(result, ratio);
+
+      // moving the result into the right octant and quadrant
+    result = _mm256_blendv_ps(result, _mm256_sub_ps(_mm256_set1_ps(c_pi / 2.0f), result), _mm256_cmp_ps(absY, absX, _CMP_GT_OQ));
+    result = _mm256_blendv_ps(result, _mm256_sub_ps(_mm256_set1_ps(c_pi), result), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ));
+    return _mm256_xor_ps(result, _mm256_and_ps(signMask, y));
+  }
+
+  PARTICLE_TARGET_AVX2 void UpdateLifetimesAVX2(kernelStreams& s, unsigned pBegin, unsigned pEnd, float dt)
+  {
+    const __m256 timeStep = _mm256_set1_ps(dt);
+
+    unsigned i = pBegin;
+    for (; i + 8 <= pEnd; i += 8)
+      _mm256_storeu_ps(s.m_currentLifetime + i, _mm256_add_ps(_mm256_loadu_ps(s.m_currentLifetime + i), timeStep));
+
+    _mm256_zeroupper();
+    UpdateLifetimesScalar(s, i, pEnd, dt);
+  }
+
+  template <unsigned t_features>
+  PARTICLE_TARGET_AVX2 void UpdateParticlesAVX2(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::updateParameters& pParameters)
+  {
+    const vector4& initialColor = pParameters.m_initialColor;
+    const vector4& finalColor = pParameters.m_finalColor;
+    const __m256 initialR = _mm256_set1_ps(initialColor.x), deltaR = _mm256_set1_ps(finalColor.x - initialColor.x);
+    const __m256 initialG = _mm256_set1_ps(initialColor.y), deltaG = _mm256_set1_ps(finalColor.y - initialColor.y);
+    const __m256 initialB = _mm256_set1_ps(initialColor.z), deltaB = _mm256_set1_ps(finalColor.z - initialColor.z);
+    const __m256 initialA = _mm256_set1_ps(initialColor.w), deltaA = _mm256_set1_ps(finalColor.w - initialColor.w);
+
+    float dt = pParameters.m_dt;
+    const __m256 forceX = _mm256_set1_ps(pParameters.m_accumulatedForce.x * (dt / 2.0f));
+    const __m256 forceY = _mm256_set1_ps(pParameters.m_accumulatedForce.y * (dt / 2.0f));
+    const __m256 halfForceX = _mm256_mul_ps(forceX, _mm256_set1_ps(0.5f));
+    const __m256 halfForceY = _mm256_mul_ps(forceY, _mm256_set1_ps(0.5f));
+    const __m256 timeStep = _mm256_set1_ps(dt);
+    const __m256 zero = _mm256_setzero_ps();
+
+    unsigned i = pBegin;
+    for (; i + 8 <= pEnd; i += 8)
+    {
+      __m256 lifetime = _mm256_add_ps(_mm256_loadu_ps(s.m_currentLifetime + i), timeStep);
+      _mm256_storeu_ps(s.m_currentLifetime + i, lifetime);
+
+      if (t_features & (ParticleKernels::uf_colors | ParticleKernels::uf_scales))
+      {
+        __m256 t = _mm256_div_ps(lifetime, _mm256_loadu_ps(s.m_totalLifetime + i));
+
+        if (t_features & ParticleKernels::uf_colors)
+        {
+          _mm256_storeu_ps(s.m_colorR + i, _mm256_add_ps(initialR, _mm256_mul_ps(deltaR, t)));
+          _mm256_storeu_ps(s.m_colorG + i, _mm256_add_ps(initialG, _mm256_mul_ps(deltaG, t)));
+          _mm256_storeu_ps(s.m_colorB + i, _mm256_add_ps(initialB, _mm256_mul_ps(deltaB, t)));
+          _mm256_storeu_ps(s.m_colorA + i, _mm256_add_ps(initialA, _mm256_mul_ps(deltaA, t)));
+        }
+
+        if (t_features & ParticleKernels::uf_scales)
+        {
+          __m256 pairs0 = _mm256_loadu_ps(s.m_randomScale + i * 2);
+          __m256 pairs1 = _mm256_loadu_ps(s.m_randomScale + i * 2 + 8);
+          __m256 initialScale = _mm256_shuffle_ps(pairs0, pairs1, _MM_SHUFFLE(2, 0, 2, 0));
+          __m256 finalScale = _mm256_shuffle_ps(pairs0, pairs1, _MM_SHUFFLE(3, 1, 3, 1));
+          initialScale = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(initialScale), _MM_SHUFFLE(3, 1, 2, 0)));
+          finalScale = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(finalScale), _MM_SHUFFLE(3, 1, 2, 0)));
+          _mm256_storeu_ps(s.m_scale + i, _mm256_add_ps(initialScale, _mm256_mul_ps(_mm256_sub_ps(finalScale, initialScale), t)));
+        }
+      }
+
+      __m256 positionX = _mm256_loadu_ps(s.m_positionX + i);
+      __m256 positionY = _mm256_loadu_ps(s.m_positionY + i);
+      _mm256_storeu_ps(s.m_oldPositionX + i, positionX);
+      _mm256_storeu_ps(s.m_oldPositionY + i, positionY);
+
+      __m256 velocityX, velocityY;
+      if (t_features & ParticleKernels::uf_fixedStep)
+      {
+        velocityX = _mm256_add_ps(_mm256_loadu_ps(s.m_velocityX + i), _mm256_loadu_ps(s.m_forceX + i));
+        velocityY = _mm256_add_ps(_mm256_loadu_ps(s.m_velocityY + i), _mm256_loadu_ps(s.m_forceY + i));
+        _mm256_storeu_ps(s.m_positionX + i, _mm256_add_ps(positionX, _mm256_mul_ps(_mm256_add_ps(velocityX, halfForceX), timeStep)));
+        _mm256_storeu_ps(s.m_positionY + i, _mm256_add_ps(positionY, _mm256_mul_ps(_mm256_add_ps(velocityY, halfForceY), timeStep)));
+        velocityX = _mm256_add_ps(velocityX, forceX);
+        velocityY = _mm256_add_ps(velocityY, forceY);
+      }
+      else
+      {
+        velocityX = _mm256_add_ps(_mm256_loadu_ps(s.m_velocityX + i), _mm256_add_ps(forceX, _mm256_loadu_ps(s.m_forceX + i)));
+        velocityY = _mm256_add_ps(_mm256_loadu_ps(s.m_velocityY + i), _mm256_add_ps(forceY, _mm256_loadu_ps(s.m_forceY + i)));
+        _mm256_storeu_ps(s.m_positionX + i, _mm256_add_ps(positionX, _mm256_mul_ps(velocityX, timeStep)));
+        _mm256_storeu_ps(s.m_positionY + i, _mm256_add_ps(positionY, _mm256_mul_ps(velocityY, timeStep)));
+      }
+      _mm256_storeu_ps(s.m_velocityX + i, velocityX);
+      _mm256_storeu_ps(s.m_velocityY + i, velocityY);
+
+      if (t_features & ParticleKernels::uf_spinning)
+      {
+        __m256 angularVelocity = _mm256_loadu_ps(s.m_angularVelocity + i);
+        __m256 spinning = _mm256_add_ps(_mm256_loadu_ps(s.m_rotation + i), _mm256_mul_ps(angularVelocity, timeStep));
+
+        if (t_features & ParticleKernels::uf_facing)
+        {
+          spinning = _mm256_blendv_ps(spinning, Atan2AVX2(velocityY, velocityX), _mm256_cmp_ps(angularVelocity, zero, _CMP_EQ_OQ));
+        }
+        _mm256_storeu_ps(s.m_rotation + i, spinning);
+      }
+      else if (t_features & ParticleKernels::uf_facing)
+        _mm256_storeu_ps(s.m_rotation + i, Atan2AVX2(velocityY, velocityX));
+
+      _mm256_storeu_ps(s.m_forceX + i, zero);
+      _mm256_storeu_ps(s.m_forceY + i, zero);
+    }
+
+      // the upper halves of the ymm registers are cleared before any SSE code runs,
+      // otherwise every SSE instruction after the kernel pays for the transition
+    _mm256_zeroupper();
+    UpdateParticlesScalar<t_features>(s, i, pEnd, pParameters);
+  }
+
+  PARTICLE_TARGET_AVX2 void EvaluateParticlesAVX2(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::evaluateParameters& pParameters, const ParticleKernels::evaluatedColumns& c)
+  {
+    const vector4& initialColor = pParameters.m_initialColor;
+    const vector4& finalColor = pParameters.m_finalColor;
+    const __m256 initialR = _mm256_set1_ps(initialColor.x), deltaR = _mm256_set1_ps(finalColor.x - initialColor.x);
+    const __m256 initialG = _mm256_set1_ps(initialColor.y), deltaG = _mm256_set1_ps(finalColor.y - initialColor.y);
+    const __m256 initialB = _mm256_set1_ps(initialColor.z), deltaB = _mm256_set1_ps(finalColor.z - initialColor.z);
+    const __m256 initialA = _mm256_set1_ps(initialColor.w), deltaA = _mm256_set1_ps(finalColor.w - initialColor.w);
+
+    const __m256 accelerationX = _mm256_set1_ps(pParameters.m_acceleration.x);
+    const __m256 accelerationY = _mm256_set1_ps(pParameters.m_acceleration.y);
+    const __m256 timeOffset = _mm256_set1_ps(pParameters.m_timeOffset);
+    const __m256 half = _mm256_set1_ps(0.5f), quarter = _mm256_set1_ps(0.25f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    unsigned i = pBegin;
+    for (; i + 8 <= pEnd; i += 8)
+    {
+      unsigned column = i - pBegin;
+      __m256 age = _mm256_max_ps(_mm256_add_ps(_mm256_loadu_ps(s.m_currentLifetime + i), timeOffset), zero);
+      __m256 t = _mm256_div_ps(age, _mm256_loadu_ps(s.m_totalLifetime + i));
+      __m256 halfAge = _mm256_mul_ps(age, half);
+      __m256 quarterAgeSquared = _mm256_mul_ps(_mm256_mul_ps(age, age), quarter);
+
+        // same closed form as the scalar kernel
+      __m256 spawnVelocityX = _mm256_loadu_ps(s.m_velocityX + i);
+      __m256 spawnVelocityY = _mm256_loadu_ps(s.m_velocityY + i);
+      __m256 velocityX = _mm256_add_ps(spawnVelocityX, _mm256_mul_ps(accelerationX, halfAge));
+      __m256 velocityY = _mm256_add_ps(spawnVelocityY, _mm256_mul_ps(accelerationY, halfAge));
+      __m256 positionX = _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(s.m_positionX + i), _mm256_mul_ps(spawnVelocityX, age)), _mm256_mul_ps(accelerationX, quarterAgeSquared));
+      __m256 positionY = _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(s.m_positionY + i), _mm256_mul_ps(spawnVelocityY, age)), _mm256_mul_ps(accelerationY, quarterAgeSquared));
+
+      __m256 angularVelocity = _mm256_loadu_ps(s.m_angularVelocity + i);
+      __m256 spinning = _mm256_add_ps(_mm256_loadu_ps(s.m_rotation + i), _mm256_mul_ps(angularVelocity, age));
+      __m256 isFacing = _mm256_cmp_ps(angularVelocity, zero, _CMP_EQ_OQ);
+      __m256 rotation = spinning;
+
+        // the atan is only worked out if a particle needs it, most emitters spin all of theirs
+      if (_mm256_movemask_ps(isFacing))
+        rotation = _mm256_blendv_ps(spinning, Atan2AVX2(velocityY, velocityX), isFacing);
+
+      __m256 pairs0 = _mm256_loadu_ps(s.m_randomScale + i * 2);
+      __m256 pairs1 = _mm256_loadu_ps(s.m_randomScale + i * 2 + 8);
+      __m256 initialScale = _mm256_shuffle_ps(pairs0, pairs1, _MM_SHUFFLE(2, 0, 2, 0));
+      __m256 finalScale = _mm256_shuffle_ps(pairs0, pairs1, _MM_SHUFFLE(3, 1, 3, 1));
+      initialScale = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(initialScale), _MM_SHUFFLE(3, 1, 2, 0)));
+      finalScale = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(finalScale), _MM_SHUFFLE(3, 1, 2, 0)));
+
+        // only written once everything is read, so the particles can be evaluated in place
+      _mm256_storeu_ps(c.m_positionX + column, positionX);
+      _mm256_storeu_ps(c.m_positionY + column, positionY);
+      _mm256_storeu_ps(c.m_rotation + column, rotation);
+      _mm256_storeu_ps(c.m_scale + column, _mm256_add_ps(initialScale, _mm256_mul_ps(_mm256_sub_ps(finalScale, initialScale), t)));
+      _mm256_storeu_ps(c.m_colorR + column, _mm256_add_ps(initialR, _mm256_mul_ps(deltaR, t)));
+      _mm256_storeu_ps(c.m_colorG + column, _mm256_add_ps(initialG, _mm256_mul_ps(deltaG, t)));
+      _mm256_storeu_ps(c.m_colorB + column, _mm256_add_ps(initialB, _mm256_mul_ps(deltaB, t)));
+      _mm256_storeu_ps(c.m_colorA + column, _mm256_add_ps(initialA, _mm256_mul_ps(deltaA, t)));
+    }
+
+    _mm256_zeroupper();
+    EvaluateParticlesScalar(s, i, pEnd, pParameters, AdvanceColumns(c, i - pBegin));
+  }
+
+  PARTICLE_TARGET_AVX2 unsigned MarkDeadParticlesAVX2(kernelStreams& s, unsigned pBegin, unsigned pEnd)
+  {
+    unsigned deathCount = 0;
+
+    unsigned i = pBegin;
+    for (; i + 8 <= pEnd; i += 8)
+    {
+      unsigned deadMask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(s.m_currentLifetime + i), _mm256_loadu_ps(s.m_totalLifetime + i), _CMP_GT_OQ));
+      for (; deadMask; deadMask &= deadMask - 1)
+      {
+        s.m_isActive[i + LowestBit(deadMask)] = false;
+        ++deathCount;
+      }
+    }
+
+    _mm256_zeroupper();
+    return deathCount + MarkDeadParticlesScalar(s, i, pEnd);
+  }
+
+  PARTICLE_TARGET_AVX2 unsigned FindParticlesInPolygonAVX2(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::polygonPlanes& pPolygon, unsigned* pInside)
+  {
+    const __m256 minX = _mm256_set1_ps(pPolygon.m_minX);
+    const __m256 minY = _mm256_set1_ps(pPolygon.m_minY);
+    const __m256 maxX = _mm256_set1_ps(pPolygon.m_maxX);
+    const __m256 maxY = _mm256_set1_ps(pPolygon.m_maxY);
+    const __m256 zero = _mm256_setzero_ps();
+
+    unsigned insideCount = 0;
+
+    unsigned i = pBegin;
+    for (; i + 8 <= pEnd; i += 8)
+    {
+      __m256 x = _mm256_loadu_ps(s.m_positionX + i);
+      __m256 y = _mm256_loadu_ps(s.m_positionY + i);
+
+        // the faces are only checked while some of the batch could still be inside
+      __m256 outside = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(x, minX, _CMP_LT_OQ), _mm256_cmp_ps(x, maxX, _CMP_GT_OQ)),
+                                    _mm256_or_ps(_mm256_cmp_ps(y, minY, _CMP_LT_OQ), _mm256_cmp_ps(y, maxY, _CMP_GT_OQ)));
+      for (unsigned plane = 0; (plane < pPolygon.m_planeCount) && (_mm256_movemask_ps(outside) != 0xFF); ++plane)
+      {
+        const float* halfPlane = pPolygon.m_planes + plane * 3;
+        __m256 distance = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(halfPlane[0]), x), _mm256_mul_ps(_mm256_set1_ps(halfPlane[1]), y)), _mm256_set1_ps(halfPlane[2]));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, zero, _CMP_GT_OQ));
+      }
+
+      for (unsigned insideMask = _mm256_movemask_ps(outside) ^ 0xFF; insideMask; insideMask &= insideMask - 1)
+        pInside[insideCount++] = i + LowestBit(insideMask);
+    }
+
+    _mm256_zeroupper();
+    return insideCount + FindParticlesInPolygonScalar(s, i, pEnd, pPolygon, pInside + insideCount);
+  }
+
+  PARTICLE_TARGET_AVX2 unsigned FindParticlesInCircleAVX2(kernelStreams& s, unsigned pBegin, unsigned pEnd, const ParticleKernels::circleShape& pCircle, unsigned* pInside)
+  {
+    const __m256 centerX = _mm256_set1_ps(pCircle.m_centerX);
+    const __m256 centerY = _mm256_set1_ps(pCircle.m_centerY);
+    const __m256 radiusSquared = _mm256_set1_ps(pCircle.m_radius * pCircle.m_radius);
+
+    unsigned insideCount = 0;
+
+    unsigned i = pBegin;
+    for (; i + 8 <= pEnd; i += 8)
+    {
+      __m256 offsetX = _mm256_sub_ps(_mm256_loadu_ps(s.m_positionX + i), centerX);
+      __m256 offsetY = _mm256_sub_ps(_mm256_loadu_ps(s.m_positionY + i), centerY);
+      __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(offsetX, offsetX), _mm256_mul_ps(offsetY, offsetY));
+
+      for (unsigned insideMask = _mm256_movemask_ps(_mm256_cmp_ps(distanceSquared, radiusSquared, _CMP_LE_OQ)); insideMask; insideMask &= insideMask - 1)
+        pInside[insideCount++] = i + LowestBit(insideMask);
+    }
+
+    _mm256_zeroupper();
+    return insideCount + FindParticlesInCircleScalar(s, i, pEnd, pCircle, pInside + insideCount);
+  }
+
+  PARTICLE_TARGET_AVX2 void ComputeBoundsAVX2(kernelStreams& s, unsigned pBegin, unsigned pEnd, float pBounds[4])
+  {
+    __m256 minX = _mm256_set1_ps(pBounds[0]);
+    __m256 minY = _mm256_set1_ps(pBounds[1]);
+    __m256 maxX = _mm256_set1_ps(pBounds[2]);
+    __m256 maxY = _mm256_set1_ps(pBounds[3]);
+
+    unsigned i = pBegin;
+    for (; i + 8 <= pEnd; i += 8)
+    {
+      __m256 x = _mm256_loadu_ps(s.m_positionX + i);
+      __m256 y = _mm256_loadu_ps(s.m_positionY + i);
+      minX = _mm256_min_ps(minX, x);
+      minY = _mm256_min_ps(minY, y);
+      maxX = _mm256_max_ps(maxX, x);
+      maxY = _mm256_max_ps(maxY, y);
+    }
+
+      // folding the lanes together
+    float lanes[4][8];
+    _mm256_storeu_ps(lanes[0], minX);
+    _mm256_storeu_ps(lanes[1], minY);
+    _mm256_storeu_ps(lanes[2], maxX);
+    _mm256_storeu_ps(lanes[3], maxY);
+
+    for (unsigned lane = 0; lane < 8; ++lane)
+    {
+      pBounds[0] = (lanes[0][lane] < pBounds[0]) ? lanes[0][lane] : pBounds[0];
+      pBounds[1] = (lanes[1][lane] < pBounds[1]) ? lanes[1][lane] : pBounds[1];
+      pBounds[2] = (lanes[2][lane] > pBounds[2]) ? lanes[2][lane] : pBounds[2];
+      pBounds[3] = (lanes[3][lane] > pBounds[3]) ? lanes[3][lane] : pBounds[3];
+    }
+
+    _mm256_zeroupper();
+    ComputeBoundsScalar(s, i, pEnd, pBounds);
+  }
+
+    // same as FloatToHalf, 8 at a time (the half floats are in the low 16 bits of a lane)
+  PARTICLE_TARGET_AVX2 __m256i FloatToHalfAVX2(__m256 pValues)
+  {
+    __m256i bits = _mm256_castps_si256(pValues);
+    __m256i sign = _mm256_and_si256(bits, _mm256_set1_epi32(static_cast<int>(0x80000000u)));
+    bits = _mm256_xor_si256(bits, sign);
+
+      // the bits without the sign are positive, so signed compares work
+    __m256i isOverflow = _mm256_cmpgt_epi32(bits, _mm256_set1_epi32(c_halfOverflow - 1));
+    __m256i isNaN = _mm256_cmpgt_epi32(bits, _mm256_set1_epi32(c_floatInfinity));
+    __m256i isDenormal = _mm256_cmpgt_epi32(_mm256_set1_epi32(c_halfNormal), bits);
+
+    __m256i overflow = _mm256_or_si256(_mm256_set1_epi32(0x7C00), _mm256_and_si256(isNaN, _mm256_set1_epi32(0x0200)));
+    __m256 denormalMagic = _mm256_castsi256_ps(_mm256_set1_epi32(c_halfDenormalMagic));
+    __m256i denormal = _mm256_sub_epi32(_mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(bits), denormalMagic)), _mm256_castps_si256(denormalMagic));
+    __m256i roundOdd = _mm256_and_si256(_mm256_srli_epi32(bits, 13), _mm256_set1_epi32(1));
+    __m256i normal = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(bits, _mm256_set1_epi32(static_cast<int>(c_halfRebias))), roundOdd), 13);
+
+    __m256i half = _mm256_blendv_epi8(normal, denormal, isDenormal);
+    half = _mm256_blendv_epi8(half, overflow, isOverflow);
+    return _mm256_or_si256(half, _mm256_srli_epi32(sign, 16));
+  }
+
+    // same as WrapAngle, 8 at a time
+  PARTICLE_TARGET_AVX2 __m256 WrapAngleAVX2(__m256 pAngles)
+  {
+    __m256 turns = _mm256_floor_ps(_mm256_mul_ps(_mm256_add_ps(pAngles, _mm256_set1_ps(c_pi)), _mm256_set1_ps(c_inverseTwoPi)));
+    return _mm256_sub_ps(pAngles, _mm256_mul_ps(turns, _mm256_set1_ps(2.0f * c_pi)));
+  }
+
+    // same as ColorToByte, 8 at a time
+  PARTICLE_TARGET_AVX2 __m256i ColorToByteAVX2(__m256 pValues)
+  {
+    pValues = _mm256_min_ps(_mm256_max_ps(pValues, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+    return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(pValues, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f)));
+  }
+
+  PARTICLE_TARGET_AVX2 void PackParticlesAVX2(const ParticleKernels::packSource& s, unsigned pBegin, unsigned pEnd, ParticleKernels::packedParticle* pPacked)
+  {
+    __m256 originX = _mm256_set1_ps(s.m_originX);
+    __m256 originY = _mm256_set1_ps(s.m_originY);
+    __m256 originZ = _mm256_set1_ps(s.m_originZ);
+
+    unsigned i = pBegin;
+    for (; i + 8 <= pEnd; i += 8)
+    {
+      __m256i x = FloatToHalfAVX2(_mm256_sub_ps(_mm256_loadu_ps(s.m_positionX + i), originX));
+      __m256i y = FloatToHalfAVX2(_mm256_sub_ps(_mm256_loadu_ps(s.m_positionY + i), originY));
+      __m256i z = FloatToHalfAVX2(_mm256_sub_ps(_mm256_loadu_ps(s.m_positionZ + i), originZ));
+      __m256i rotation = FloatToHalfAVX2(WrapAngleAVX2(_mm256_loadu_ps(s.m_rotation + i)));
+      __m256i scale = FloatToHalfAVX2(_mm256_loadu_ps(s.m_scale + i));
+
+      __m256i color = ColorToByteAVX2(_mm256_loadu_ps(s.m_colorR + i));
+      color = _mm256_or_si256(color, _mm256_slli_epi32(ColorToByteAVX2(_mm256_loadu_ps(s.m_colorG + i)), 8));
+      color = _mm256_or_si256(color, _mm256_slli_epi32(ColorToByteAVX2(_mm256_loadu_ps(s.m_colorB + i)), 16));
+      color = _mm256_or_si256(color, _mm256_slli_epi32(ColorToByteAVX2(_mm256_loadu_ps(s.m_colorA + i)), 24));
+
+      __m256i word0 = _mm256_or_si256(x, _mm256_slli_epi32(y, 16));
+      __m256i word1 = _mm256_or_si256(z, _mm256_slli_epi32(rotation, 16));
+
+        // the two halves are stored 4 particles at a time
+      StorePackedSSE2(_mm256_castsi256_si128(word0), _mm256_castsi256_si128(word1), _mm256_castsi256_si128(scale), _mm256_castsi256_si128(color), pPacked + i);
+      StorePackedSSE2(_mm256_extracti128_si256(word0, 1), _mm256_extracti128_si256(word1, 1), _mm256_extracti128_si256(scale, 1),
+                      _mm256_extracti128_si256(color, 1), pPacked + i + 4);
+    }
+
+    _mm256_zeroupper();
+    PackParticlesScalar(s, i, pEnd, pPacked);
+  }
+
+  /*!***********************************************************************************
+  \brief  checks if the cpu (and os) support AVX2
+  *************************************************************************************/
+  bool IsAVX2Supported()
+  {
+  #if defined(_MSC_VER)
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 0);
+    if (cpuInfo[0] < 7)
+      return false;
+
+      // the os has to save the ymm registers as well
+    __cpuid(cpuInfo, 1);
+    bool osSavesAVX = (cpuInfo[2] & (1 << 27)) && (cpuInfo[2] & (1 << 28));
+    if (!osSavesAVX || (_xgetbv(0) & 6) != 6)
+      return false;
+
+    __cpuidex(cpuInfo, 7, 0);
+    return (cpuInfo[1] & (1 << 5)) != 0;
+  #else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  #endif
+  }
+#endif
+
+  /*!***********************************************************************************
+  \brief  best instruction set the cpu supports
+  *************************************************************************************/
+  ParticleKernels::instructionSet GetSupportedInstructionSet()
+  {
+  #ifdef PARTICLE_KERNELS_X86
+    if (IsAVX2Supported())
+      return ParticleKernels::is_avx2;
+    return ParticleKernels::is_sse2;
+  #else
+    return ParticleKernels::is_scalar;
+  #endif
+  }
+
+    // instruction set used by all kernels, picked once on startup
+  ParticleKernels::instructionSet s_instructionSet = GetSupportedInstructionSet();
+
+  /*!***********************************************************************************
+  \brief  update kernel of an instruction set for a combination of stages (the switch is
+          resolved when it's compiled)
+  *************************************************************************************/
+  template <ParticleKernels::instructionSet t_instructionSet, unsigned t_features>
+  void UpdateParticles(particleStorage& pStorage, unsigned pBegin, unsigned pEnd, const ParticleKernels::updateParameters& pParameters)
+  {
+    kernelStreams streams(pStorage);
+
+    switch (t_instructionSet)
+    {
+  #ifdef PARTICLE_KERNELS_X86
+    case ParticleKernels::is_avx2:
+      UpdateParticlesAVX2<t_features>(streams, pBegin, pEnd, pParameters);
+      break;
+    case ParticleKernels::is_sse2:
+      UpdateParticlesSSE2<t_features>(streams, pBegin, pEnd, pParameters);
+      break;
+  #endif
+    default:
+      UpdateParticlesScalar<t_features>(streams, pBegin, pEnd, pParameters);
+      break;
+    }
+  }
+
+  /*!***********************************************************************************
+  \brief  looks an update kernel up in the table of every instruction set and every
+          combination of stages
+  *************************************************************************************/
+  template <unsigned... t_features>
+  ParticleKernels::updateKernel FindUpdateKernel(ParticleKernels::instructionSet pInstructionSet, unsigned pFeatures, std::integer_sequence<unsigned, t_features...>)
+  {
+    static const ParticleKernels::updateKernel c_kernels[3][sizeof...(t_features)] =
+    {
+      { &UpdateParticles<ParticleKernels::is_scalar, t_features>... },
+      { &UpdateParticles<ParticleKernels::is_sse2, t_features>... },
+      { &UpdateParticles<ParticleKernels::is_avx2, t_features>... }
+    };
+
+    return c_kernels[pInstructionSet][pFeatures];
+  }
+}
+
+namespace ParticleKernels
+{
+  instructionSet GetInstructionSet()
+  {
+    return s_instructionSet;
+  }
+
+  instructionSet SetInstructionSet(instructionSet pInstructionSet)
+  {
+    instructionSet supported = GetSupportedInstructionSet();
+    s_instructionSet = (pInstructionSet < supported) ? pInstructionSet : supported;
+    return s_instructionSet;
+  }
+
+  void UpdateLifetimes(particleStorage& pStorage, unsigned pBegin, unsigned pEnd, float dt)
+  {
+    kernelStreams streams(pStorage);
+
+    switch (s_instructionSet)
+    {
+  #ifdef PARTICLE_KERNELS_X86
+    case is_avx2:
+      UpdateLifetimesAVX2(streams, pBegin, pEnd, dt);
+      break;
+    case is_sse2:
+      UpdateLifetimesSSE2(streams, pBegin, pEnd, dt);
+      break;
+  #endif
+    default:
+      UpdateLifetimesScalar(streams, pBegin, pEnd, dt);
+      break;
+    }
+  }
+
+  updateKernel GetUpdateKernel(unsigned pFeatures)
+  {
+    return FindUpdateKernel(s_instructionSet, pFeatures & uf_all, std::make_integer_sequence<unsigned, uf_all + 1>());
+  }
+
+  unsigned MarkDeadParticles(particleStorage& pStorage, unsigned pBegin, unsigned pEnd)
+  {
+    kernelStreams streams(pStorage);
+
+    switch (s_instructionSet)
+    {
+  #ifdef PARTICLE_KERNELS_X86
+    case is_avx2:
+      return MarkDeadParticlesAVX2(streams, pBegin, pEnd);
+    case is_sse2:
+      return MarkDeadParticlesSSE2(streams, pBegin, pEnd);
+  #endif
+    default:
+      return MarkDeadParticlesScalar(streams, pBegin, pEnd);
+    }
+  }
+
+  unsigned FindParticlesInPolygon(particleStorage& pStorage, unsigned pBegin, unsigned pEnd, const polygonPlanes& pPolygon, unsigned* pInside)
+  {
+    kernelStreams streams(pStorage);
+
+    switch (s_instructionSet)
+    {
+  #ifdef PARTICLE_KERNELS_X86
+    case is_avx2:
+      return FindParticlesInPolygonAVX2(streams, pBegin, pEnd, pPolygon, pInside);
+    case is_sse2:
+      return FindParticlesInPolygonSSE2(streams, pBegin, pEnd, pPolygon, pInside);
+  #endif
+    default:
+      return FindParticlesInPolygonScalar(streams, pBegin, pEnd, pPolygon, pInside);
+    }
+  }
+
+  unsigned FindParticlesInCircle(particleStorage& pStorage, unsigned pBegin, unsigned pEnd, const circleShape& pCircle, unsigned* pInside)
+  {
+    kernelStreams streams(pStorage);
+
+    switch (s_instructionSet)
+    {
+  #ifdef PARTICLE_KERNELS_X86
+    case is_avx2:
+      return FindParticlesInCircleAVX2(streams, pBegin, pEnd, pCircle, pInside);
+    case is_sse2:
+      return FindParticlesInCircleSSE2(streams, pBegin, pEnd, pCircle, pInside);
+  #endif
+    default:
+      return FindParticlesInCircleScalar(streams, pBegin, pEnd, pCircle, pInside);
+    }
+  }
+
+  void ComputeBounds(const particleStorage& pStorage, unsigned pBegin, unsigned pEnd, float pBounds[4])
+  {
+      // the positions are only read
+    kernelStreams streams(const_cast<particleStorage&>(pStorage));
+
+      // starting with the first particle, so the lanes never see an empty box
+    pBounds[0] = pBounds[2] = pStorage.m_positionX[pBegin];
+    pBounds[1] = pBounds[3] = pStorage.m_positionY[pBegin];
+
+    switch (s_instructionSet)
+    {
+  #ifdef PARTICLE_KERNELS_X86
+    case is_avx2:
+      ComputeBoundsAVX2(streams, pBegin, pEnd, pBounds);
+      break;
+    case is_sse2:
+      ComputeBoundsSSE2(streams, pBegin, pEnd, pBounds);
+      break;
+  #endif
+    default:
+      ComputeBoundsScalar(streams, pBegin, pEnd, pBounds);
+      break;
+    }
+  }
+
+  void EvaluateParticles(const particleStorage& pStorage, unsigned pBegin, unsigned pEnd, const evaluateParameters& pParameters, const evaluatedColumns& pColumns)
+  {
+      // the spawn state is only read
+    kernelStreams streams(const_cast<particleStorage&>(pStorage));
+
+    switch (s_instructionSet)
+    {
+  #ifdef PARTICLE_KERNELS_X86
+    case is_avx2:
+      EvaluateParticlesAVX2(streams, pBegin, pEnd, pParameters, pColumns);
+      break;
+    case is_sse2:
+      EvaluateParticlesSSE2(streams, pBegin, pEnd, pParameters, pColumns);
+      break;
+  #endif
+    default:
+      EvaluateParticlesScalar(streams, pBegin, pEnd, pParameters, pColumns);
+      break;
+    }
+  }
+
+  void PackParticles(const packSource& pSource, unsigned pCount, packedParticle* pPacked)
+  {
+    switch (s_instructionSet)
+    {
+  #ifdef PARTICLE_KERNELS_X86
+    case is_avx2:
+      PackParticlesAVX2(pSource, 0, pCount, pPacked);
+      break;
+    case is_sse2:
+      PackParticlesSSE2(pSource, 0, pCount, pPacked);
+      break;
+  #endif
+    default:
+      PackParticlesScalar(pSource, 0, pCount, pPacked);
+      break;
+    }
+  }
+
+  void PackParticles(const particleStorage& pStorage, unsigned pBegin, unsigned pEnd, const vector4& pOrigin, packedParticle* pPacked)
+  {
+    packSource source;
+    source.m_positionX = pStorage.m_positionX + pBegin;
+    source.m_positionY = pStorage.m_positionY + pBegin;
+    source.m_positionZ = pStorage.m_positionZ + pBegin;
+    source.m_rotation = pStorage.m_rotation + pBegin;
+    source.m_scale = pStorage.m_scale + pBegin;
+    source.m_colorR = pStorage.m_colorR + pBegin;
+    source.m_colorG = pStorage.m_colorG + pBegin;
+    source.m_colorB = pStorage.m_colorB + pBegin;
+    source.m_colorA = pStorage.m_colorA + pBegin;
+    source.m_originX = pOrigin.x;
+    source.m_originY = pOrigin.y;
+    source.m_originZ = pOrigin.z;
+
+    PackParticles(source, pEnd - pBegin, pPacked);
+  }
+
+  unsigned CompactParticles(particleStorage& pStorage, unsigned pCount)
+  {
+    unsigned (*findInactive)(const unsigned char*, unsigned, unsigned) = FindInactiveScalar;
+    unsigned (*findLastActive)(const unsigned char*, unsigned, unsigned) = FindLastActiveScalar;
+
+  #ifdef PARTICLE_KERNELS_X86
+    if (s_instructionSet != is_scalar)
+    {
+      findInactive = FindInactiveSSE2;
+      findLastActive = FindLastActiveSSE2;
+    }
+  #endif
+
+    unsigned char* isActive = pStorage.m_isActive;
+    unsigned moveCount = 0;
+
+      // [front, back) hasn't been looked at yet, everything before front is active
+    unsigned front = 0;
+    unsigned back = pCount;
+    for (;;)
+    {
+        // finding the next hole
+      front = findInactive(isActive, front, back);
+      if (front == back)
+        break;
+
+        // finding the last active particle to fill it with
+      unsigned lastActive = findLastActive(isActive, front + 1, back);
+      if (lastActive == front + 1)
+        break;
+
+      back = lastActive - 1;
+      particleMove move = { back, front };
+      pStorage.m_moves[moveCount++] = move;
+
+      isActive[front] = true;
+      isActive[back] = false;
+      ++front;
+    }
+
+      // moving the data one array at a time
+    pStorage.m_moveCount = moveCount;
+    pStorage.ApplyMoves(pStorage.m_moves, moveCount);
+    return front;
+  }
+}
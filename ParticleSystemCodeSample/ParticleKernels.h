@@ -0,0 +1,270 @@
+/*!****************************************************************************************
+\file       ParticleKernels.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particle kernels. These update a whole range of particles
+in the particle storage at once, 4 (SSE2) or 8 (AVX2) particles per instruction. The
+instruction set is picked at runtime according to what the cpu supports.
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+#include "../../../Math/Vector4.h"
+
+// forward declarations
+struct particleStorage;
+
+namespace ParticleKernels
+{
+  /*!***********************************************************************************
+  \brief  instruction sets the kernels can run with
+  *************************************************************************************/
+  enum instructionSet
+  {
+    is_scalar, //!< plain c++, one particle at a time
+    is_sse2,   //!< 4 particles at a time
+    is_avx2    //!< 8 particles at a time
+  };
+
+  /*!***********************************************************************************
+  \brief  stages of the particle update an emitter can do without. An update kernel is
+          compiled for every combination of them (see GetUpdateKernel)
+  *************************************************************************************/
+  enum updateFeature
+  {
+    uf_colors = 1 << 0,    //!< colors are interpolated from the initial to the final color
+    uf_scales = 1 << 1,    //!< scales are interpolated from the initial to the final scale
+    uf_spinning = 1 << 2,  //!< particles with an angular velocity are rotated by it
+    uf_facing = 1 << 3,    //!< particles without an angular velocity face their direction of movement
+    uf_fixedStep = 1 << 4, //!< velocity Verlet step instead of an Euler step (the position moves with the average velocity over the step, so a trajectory doesn't depend on the step)
+    uf_all = (1 << 5) - 1  //!< every stage
+  };
+
+  /*!***********************************************************************************
+  \brief  everything an update kernel needs besides the particles
+  *************************************************************************************/
+  struct updateParameters
+  {
+    vector4 m_accumulatedForce; //!< forces accumulated over the past frame
+    vector4 m_initialColor;     //!< color of a particle that just spawned
+    vector4 m_finalColor;       //!< color of a particle about to die
+    float m_dt;                 //!< time passed since last frame (or the length of the fixed step)
+  };
+
+  /*!***********************************************************************************
+  \brief  everything the closed form needs besides the particles (see EvaluateParticles)
+  *************************************************************************************/
+  struct evaluateParameters
+  {
+    vector4 m_acceleration; //!< constant acceleration of the particles
+    vector4 m_initialColor; //!< color of a particle that just spawned
+    vector4 m_finalColor;   //!< color of a particle about to die
+    float m_timeOffset;     //!< added to the lifetimes of the particles to get the age they're evaluated at
+  };
+
+  /*!***********************************************************************************
+  \brief  the columns evaluated particles are written to (index 0 is the first particle
+          evaluated)
+  *************************************************************************************/
+  struct evaluatedColumns
+  {
+    float *m_positionX, *m_positionY;                 //!< position of every particle (z never changes)
+    float *m_rotation, *m_scale;                      //!< rotation and scale of every particle
+    float *m_colorR, *m_colorG, *m_colorB, *m_colorA; //!< color of every particle
+  };
+
+  /*!***********************************************************************************
+  \brief  a convex polygon in world space as the half planes of its faces
+  *************************************************************************************/
+  struct polygonPlanes
+  {
+    const float* m_planes; //!< normal x, normal y and distance from the origin of every face (3 floats each)
+    unsigned m_planeCount; //!< number of faces
+
+    float m_minX; //!< left of the polygon's bounding box
+    float m_minY; //!< bottom of the polygon's bounding box
+    float m_maxX; //!< right of the polygon's bounding box
+    float m_maxY; //!< top of the polygon's bounding box
+  };
+
+  /*!***********************************************************************************
+  \brief  a circle in world space
+  *************************************************************************************/
+  struct circleShape
+  {
+    float m_centerX; //!< x of the center
+    float m_centerY; //!< y of the center
+    float m_radius;  //!< radius of the circle
+  };
+
+  /*!***********************************************************************************
+  \brief  a particle packed for the gpu, 16 bytes instead of a whole transform and a
+          float color
+  *************************************************************************************/
+  struct packedParticle
+  {
+    std::uint16_t m_position[3]; //!< x, y and z as half floats (relative to an origin)
+    std::uint16_t m_rotation;    //!< rotation as a half float
+    std::uint16_t m_scale;       //!< scale as a half float
+    std::uint16_t m_padding;     //!< keeps the color 4 byte aligned
+    std::uint32_t m_color;       //!< RGBA8 color, red in the lowest byte
+  };
+
+  /*!***********************************************************************************
+  \brief  the columns the particles are packed from (usually pointing into the particle
+          storage, but can be any arrays holding the values)
+  *************************************************************************************/
+  struct packSource
+  {
+    const float *m_positionX, *m_positionY, *m_positionZ; //!< position of every particle
+    const float *m_rotation, *m_scale;                    //!< rotation and scale of every particle
+    const float *m_colorR, *m_colorG, *m_colorB, *m_colorA; //!< color of every particle
+    float m_originX, m_originY, m_originZ; //!< subtracted from the positions, so they keep their precision as half floats
+  };
+
+  /*!***********************************************************************************
+  \brief  an update kernel, ages every particle in the range and runs the stages it was
+          compiled for in the same pass
+  *************************************************************************************/
+  typedef void (*updateKernel)(particleStorage& pStorage, unsigned pBegin, unsigned pEnd, const updateParameters& pParameters);
+
+  /*!***********************************************************************************
+  \brief  Gets the instruction set the kernels currently run with (by default the best
+          one supported by the cpu)
+
+  \return instruction set used
+  *************************************************************************************/
+  instructionSet GetInstructionSet();
+
+  /*!***********************************************************************************
+  \brief  Forces the kernels to use an instruction set (mainly for testing). If the cpu
+          doesn't support it, the best supported one below it is used instead.
+
+  \param pInstructionSet - instruction set to use
+  \return instruction set actually used
+  *************************************************************************************/
+  instructionSet SetInstructionSet(instructionSet pInstructionSet);
+
+  /*!***********************************************************************************
+  \brief  Ages every particle in the range
+
+  \param pStorage - storage holding the particles
+  \param pBegin - first particle to update
+  \param pEnd - one past the last particle to update
+  \param dt - time passed since last frame
+  *************************************************************************************/
+  void UpdateLifetimes(particleStorage& pStorage, unsigned pBegin, unsigned pEnd, float dt);
+
+  /*!***********************************************************************************
+  \brief  Gets the update kernel compiled for a combination of stages. The stages that
+          aren't in it aren't checked for per particle, they aren't in the kernel at all.
+          The kernel runs with the current instruction set (kernels gotten before
+          SetInstructionSet keep the one they were gotten with).
+
+  \param pFeatures - stages to run (updateFeature values or'ed together)
+  \return kernel running the stages
+  *************************************************************************************/
+  updateKernel GetUpdateKernel(unsigned pFeatures);
+
+  /*!***********************************************************************************
+  \brief  Sets every particle in the range that lived its whole life to inactive
+
+  \param pStorage - storage holding the particles
+  \param pBegin - first particle to check
+  \param pEnd - one past the last particle to check
+  \return number of particles that died
+  *************************************************************************************/
+  unsigned MarkDeadParticles(particleStorage& pStorage, unsigned pBegin, unsigned pEnd);
+
+  /*!***********************************************************************************
+  \brief  Finds the particles in the range that are inside a convex polygon (behind all
+          of its faces). Particles outside of the polygon's bounding box are rejected
+          before the faces are checked, a whole batch of 4 (SSE2) or 8 (AVX2) at once.
+
+  \param pStorage - storage holding the particles
+  \param pBegin - first particle to check
+  \param pEnd - one past the last particle to check
+  \param pPolygon - polygon to check the particles against
+  \param pInside - filled with the indices of the particles inside (needs room for
+         pEnd - pBegin indices)
+  \return number of particles inside
+  *************************************************************************************/
+  unsigned FindParticlesInPolygon(particleStorage& pStorage, unsigned pBegin, unsigned pEnd, const polygonPlanes& pPolygon, unsigned* pInside);
+
+  /*!***********************************************************************************
+  \brief  Finds the particles in the range that are inside a circle. The distance of 4
+          (SSE2) or 8 (AVX2) particles is checked at once without branching.
+
+  \param pStorage - storage holding the particles
+  \param pBegin - first particle to check
+  \param pEnd - one past the last particle to check
+  \param pCircle - circle to check the particles against
+  \param pInside - filled with the indices of the particles inside (needs room for
+         pEnd - pBegin indices)
+  \return number of particles inside
+  *************************************************************************************/
+  unsigned FindParticlesInCircle(particleStorage& pStorage, unsigned pBegin, unsigned pEnd, const circleShape& pCircle, unsigned* pInside);
+
+  /*!***********************************************************************************
+  \brief  Gets the bounding box of the positions of the particles in the range
+
+  \param pStorage - storage holding the particles
+  \param pBegin - first particle (the range can't be empty)
+  \param pEnd - one past the last particle
+  \param pBounds - filled with min x, min y, max x and max y
+  *************************************************************************************/
+  void ComputeBounds(const particleStorage& pStorage, unsigned pBegin, unsigned pEnd, float pBounds[4]);
+
+  /*!***********************************************************************************
+  \brief  Evaluates the particles of an analytic emitter in closed form, from the state
+          they spawned with (see particleEmitter::IsAnalytic). They're evaluated at their
+          lifetime plus the time offset, but never before they spawned. Particles without
+          an angular velocity face their direction of movement. The columns can be the
+          storage's own arrays starting at pBegin, the particles are evaluated in place
+          then.
+
+  \param pStorage - storage holding the particles
+  \param pBegin - first particle to evaluate
+  \param pEnd - one past the last particle to evaluate
+  \param pParameters - acceleration, colors and time offset to evaluate with
+  \param pColumns - filled with the evaluated particles (pEnd - pBegin of them)
+  *************************************************************************************/
+  void EvaluateParticles(const particleStorage& pStorage, unsigned pBegin, unsigned pEnd, const evaluateParameters& pParameters, const evaluatedColumns& pColumns);
+
+  /*!***********************************************************************************
+  \brief  Packs particles into the compact gpu format. Rotations are wrapped to [-pi, pi)
+          first, floats are rounded to the nearest half float (ties to even, too big ones
+          become infinity) and colors are clamped to [0, 1] and rounded to 8 bits. Every
+          instruction set gives the same bits.
+
+  \param pSource - columns to pack from (index 0 is the first particle)
+  \param pCount - number of particles to pack
+  \param pPacked - filled with the packed particles
+  *************************************************************************************/
+  void PackParticles(const packSource& pSource, unsigned pCount, packedParticle* pPacked);
+
+  /*!***********************************************************************************
+  \brief  Packs the particles of the storage in the range into the compact gpu format
+
+  \param pStorage - storage holding the particles
+  \param pBegin - first particle to pack
+  \param pEnd - one past the last particle to pack
+  \param pOrigin - subtracted from the positions (usually where the emitter is)
+  \param pPacked - filled with the packed particles (pEnd - pBegin of them)
+  *************************************************************************************/
+  void PackParticles(const particleStorage& pStorage, unsigned pBegin, unsigned pEnd, const vector4& pOrigin, packedParticle* pPacked);
+
+  /*!***********************************************************************************
+  \brief  Packs all the active particles in [0, pCount) to the front of the storage in a
+          single sweep. Holes left by dead particles are filled with the last active
+          particles, so every dead particle costs one move at most.
+
+  \param pStorage - storage holding the particles (the moves that were made are left in
+         its m_moves)
+  \param pCount - number of particles to compact (the ones active last frame)
+  \return number of active particles left
+  *************************************************************************************/
+  unsigned CompactParticles(particleStorage& pStorage, unsigned pCount);
+}
@@ -0,0 +1,329 @@
+/*!****************************************************************************************
+\file       ParticleProfiler.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particleProfiler and particleEmitterProfile classes.
+******************************************************************************************/
+
+#include "ParticleProfiler.h"
+
+#ifdef PARTICLE_PROFILING
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace
+{
+  /*!***********************************************************************************
+  \brief  writes a string as a JSON string (with quotes)
+  *************************************************************************************/
+  void WriteJSONString(std::ostream& pStream, const std::string& pString)
+  {
+    pStream << '"';
+    for (char character : pString)
+    {
+      if ((character == '"') || (character == '\\'))
+        pStream << '\\' << character;
+      else if (static_cast<unsigned char>(character) < 0x20)
+        pStream << ' ';
+      else
+        pStream << character;
+    }
+    pStream << '"';
+  }
+}
+
+particleFrameStats::particleFrameStats() : m_frameTime(0.0), m_frameCount(0)
+{
+  for (unsigned i = 0; i < pc_counterCount; ++i)
+    m_counters[i] = 0;
+  for (unsigned i = 0; i < pp_phaseCount; ++i)
+    m_phaseTimes[i] = 0.0;
+}
+
+particleFrameStats& particleFrameStats::operator+=(const particleFrameStats& pOther)
+{
+  for (unsigned i = 0; i < pc_counterCount; ++i)
+    m_counters[i] += pOther.m_counters[i];
+  for (unsigned i = 0; i < pp_phaseCount; ++i)
+    m_phaseTimes[i] += pOther.m_phaseTimes[i];
+
+  m_frameTime += pOther.m_frameTime;
+  m_frameCount += pOther.m_frameCount;
+  return *this;
+}
+
+const char* particleFrameStats::GetCounterName(particleCounter pCounter)
+{
+  static const char* const c_names[pc_counterCount] = { "spawns", "deaths", "swaps", "collision tests", "collision hits" };
+  return (pCounter < pc_counterCount) ? c_names[pCounter] : "";
+}
+
+const char* particleFrameStats::GetPhaseName(particlePhase pPhase)
+{
+  static const char* const c_names[pp_phaseCount] = { "spawn", "integrate", "collision" };
+  return (pPhase < pp_phaseCount) ? c_names[pPhase] : "";
+}
+
+particleEmitterProfile::particleEmitterProfile(const std::string& pName) : m_name(pName),
+  m_id(particleProfiler::GetGlobalProfiler().RegisterEmitter(pName))
+{
+  for (unsigned i = 0; i < pc_counterCount; ++i)
+    m_counters[i] = 0;
+  for (unsigned i = 0; i < pp_phaseCount; ++i)
+    m_phaseTimes[i] = 0;
+}
+
+particleEmitterProfile::particleEmitterProfile(const particleEmitterProfile& pOther) : particleEmitterProfile(pOther.m_name)
+{
+}
+
+particleEmitterProfile& particleEmitterProfile::operator=(const particleEmitterProfile&)
+{
+  return *this;
+}
+
+void particleEmitterProfile::Count(particleCounter pCounter, unsigned pAmount)
+{
+  m_counters[pCounter].fetch_add(pAmount, std::memory_order_relaxed);
+}
+
+void particleEmitterProfile::AddPhaseTime(particlePhase pPhase, long long pStart, long long pEnd)
+{
+  m_phaseTimes[pPhase].fetch_add(pEnd - pStart, std::memory_order_relaxed);
+  particleProfiler::GetGlobalProfiler().RecordPhase(m_id, pPhase, pStart, pEnd);
+}
+
+void particleEmitterProfile::EndFrame(const particleEmitterBundle* pBundle, long long pStart, long long pEnd)
+{
+    // the jobs of the update are all joined by now, so nothing is adding to the frame
+  particleFrameStats frame;
+  for (unsigned i = 0; i < pc_counterCount; ++i)
+    frame.m_counters[i] = m_counters[i].exchange(0, std::memory_order_relaxed);
+  for (unsigned i = 0; i < pp_phaseCount; ++i)
+    frame.m_phaseTimes[i] = m_phaseTimes[i].exchange(0, std::memory_order_relaxed) * 1e-9;
+
+  frame.m_frameTime = (pEnd - pStart) * 1e-9;
+  frame.m_frameCount = 1;
+
+  m_lastFrame = frame;
+  particleProfiler::GetGlobalProfiler().RecordFrame(m_id, pBundle, frame, pStart, pEnd);
+}
+
+const particleFrameStats& particleEmitterProfile::GetLastFrame() const
+{
+  return m_lastFrame;
+}
+
+unsigned particleEmitterProfile::GetId() const
+{
+  return m_id;
+}
+
+particleProfiler::particleProfiler() : m_isTracing(false), m_traceStart(GetTime()), m_droppedEvents(0)
+{
+}
+
+void particleProfiler::BeginFrame()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_bundleStats.clear();
+}
+
+particleFrameStats particleProfiler::GetBundleStats(const particleEmitterBundle* pBundle) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto bundleStats = m_bundleStats.find(pBundle);
+  return (bundleStats != m_bundleStats.end()) ? bundleStats->second : particleFrameStats();
+}
+
+particleFrameStats particleProfiler::GetTotalStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  particleFrameStats total;
+  for (const auto& bundleStats : m_bundleStats)
+    total += bundleStats.second;
+
+  return total;
+}
+
+void particleProfiler::SetTracing(bool pIsTracing)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_isTracing = pIsTracing;
+}
+
+void particleProfiler::ClearTrace()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_events.clear();
+  m_frameStats.clear();
+  m_droppedEvents = 0;
+  m_traceStart = GetTime();
+}
+
+void particleProfiler::WriteChromeTrace(std::ostream& pStream) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+    // timestamps of the trace format are in microseconds, nanoseconds need 3 decimals
+  std::ios::fmtflags oldFlags = pStream.flags();
+  std::streamsize oldPrecision = pStream.precision();
+  pStream << std::fixed << std::setprecision(3);
+
+  pStream << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" << m_droppedEvents << "},\"traceEvents\":[";
+
+  bool isFirst = true;
+  for (const auto& thread : m_threadIds)
+  {
+    pStream << (isFirst ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.second
+            << ",\"args\":{\"name\":\"particle thread " << thread.second << "\"}}";
+    isFirst = false;
+  }
+
+  for (const traceEvent& event : m_events)
+  {
+    double start = (event.m_start - m_traceStart) / 1000.0;
+    double duration = (event.m_end - event.m_start) / 1000.0;
+    const std::string& emitterName = m_emitterNames[event.m_emitterId];
+
+    pStream << (isFirst ? "\n" : ",\n") << "{\"name\":";
+    isFirst = false;
+
+    if (event.m_phase < pp_phaseCount)
+    {
+      WriteJSONString(pStream, particleFrameStats::GetPhaseName(static_cast<particlePhase>(event.m_phase)));
+      pStream << ",\"cat\":\"particles\",\"ph\":\"X\",\"ts\":" << start << ",\"dur\":" << duration << ",\"pid\":1,\"tid\":" << event.m_threadId
+              << ",\"args\":{\"emitter\":";
+      WriteJSONString(pStream, emitterName);
+      pStream << "}}";
+      continue;
+    }
+
+      // a whole frame is a slice with the counters, and a sample on the emitter's
+      // counter track
+    const particleFrameStats& frame = m_frameStats[event.m_frameStats];
+    WriteJSONString(pStream, emitterName);
+    pStream << ",\"cat\":\"particles\",\"ph\":\"X\",\"ts\":" << start << ",\"dur\":" << duration << ",\"pid\":1,\"tid\":" << event.m_threadId << ",\"args\":{";
+    for (unsigned i = 0; i < pc_counterCount; ++i)
+      pStream << (i ? "," : "") << '"' << particleFrameStats::GetCounterName(static_cast<particleCounter>(i)) << "\":" << frame.m_counters[i];
+    for (unsigned i = 0; i < pp_phaseCount; ++i)
+      pStream << ",\"" << particleFrameStats::GetPhaseName(static_cast<particlePhase>(i)) << " ms\":" << frame.m_phaseTimes[i] * 1000.0;
+    pStream << "}},\n{\"name\":";
+
+    WriteJSONString(pStream, emitterName + " #" + std::to_string(event.m_emitterId));
+    pStream << ",\"cat\":\"particles\",\"ph\":\"C\",\"ts\":" << start << ",\"pid\":1,\"args\":{";
+    for (unsigned i = 0; i < pc_counterCount; ++i)
+      pStream << (i ? "," : "") << '"' << particleFrameStats::GetCounterName(static_cast<particleCounter>(i)) << "\":" << frame.m_counters[i];
+    pStream << "}}";
+  }
+
+  pStream << "\n]}\n";
+
+  pStream.flags(oldFlags);
+  pStream.precision(oldPrecision);
+}
+
+bool particleProfiler::WriteChromeTrace(const char* pPath) const
+{
+  std::ofstream file(pPath);
+  if (!file)
+    return false;
+
+  WriteChromeTrace(file);
+  return static_cast<bool>(file);
+}
+
+unsigned particleProfiler::RegisterEmitter(const std::string& pName)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_emitterNames.push_back(pName);
+  return static_cast<unsigned>(m_emitterNames.size() - 1);
+}
+
+void particleProfiler::RecordPhase(unsigned pEmitterId, particlePhase pPhase, long long pStart, long long pEnd)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_isTracing)
+    return;
+
+  traceEvent event = { pStart, pEnd, pEmitterId, GetThreadId(), pPhase, 0 };
+  PushEvent(event);
+}
+
+void particleProfiler::RecordFrame(unsigned pEmitterId, const particleEmitterBundle* pBundle, const particleFrameStats& pStats, long long pStart, long long pEnd)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_bundleStats[pBundle] += pStats;
+  if (!m_isTracing)
+    return;
+
+  traceEvent event = { pStart, pEnd, pEmitterId, GetThreadId(), pp_phaseCount, static_cast<unsigned>(m_frameStats.size()) };
+  if (PushEvent(event))
+    m_frameStats.push_back(pStats);
+}
+
+long long particleProfiler::GetTime()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+particleProfiler& particleProfiler::GetGlobalProfiler()
+{
+  static particleProfiler globalProfiler;
+  return globalProfiler;
+}
+
+unsigned particleProfiler::GetThreadId()
+{
+  auto thread = m_threadIds.find(std::this_thread::get_id());
+  if (thread != m_threadIds.end())
+    return thread->second;
+
+  unsigned threadId = static_cast<unsigned>(m_threadIds.size());
+  m_threadIds[std::this_thread::get_id()] = threadId;
+  return threadId;
+}
+
+bool particleProfiler::PushEvent(const traceEvent& pEvent)
+{
+    // a trace left running stops growing instead of eating all the memory
+  if (m_events.size() >= c_maxTraceEvents)
+  {
+    ++m_droppedEvents;
+    return false;
+  }
+
+  m_events.push_back(pEvent);
+  return true;
+}
+
+particlePhaseTimer::particlePhaseTimer(particleEmitterProfile& pProfile, particlePhase pPhase) : m_profile(pProfile), m_phase(pPhase),
+  m_start(particleProfiler::GetTime())
+{
+}
+
+particlePhaseTimer::~particlePhaseTimer()
+{
+  m_profile.AddPhaseTime(m_phase, m_start, particleProfiler::GetTime());
+}
+
+particleFrameTimer::particleFrameTimer(particleEmitterProfile& pProfile, const particleEmitterBundle* pBundle) : m_profile(pProfile),
+  m_bundle(pBundle), m_start(particleProfiler::GetTime())
+{
+}
+
+particleFrameTimer::~particleFrameTimer()
+{
+  m_profile.EndFrame(m_bundle, m_start, particleProfiler::GetTime());
+}
+
+#endif
@@ -0,0 +1,416 @@
+/*!****************************************************************************************
+\file       ParticleProfiler.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particleProfiler and particleEmitterProfile classes. Counts
+what every emitter does in a frame and times its phases, adds it up per emitter bundle
+and can dump all of it as a Chrome trace (chrome://tracing) to find the emitters that
+blow the frame budget.
+
+Everything is compiled out unless PARTICLE_PROFILING is defined, the PARTICLE_PROFILE_
+macros the emitter uses expand to nothing then.
+******************************************************************************************/
+#pragma once
+
+#ifdef PARTICLE_PROFILING
+  #define PARTICLE_PROFILE_CONCAT_INNER(pA, pB) pA##pB
+  #define PARTICLE_PROFILE_CONCAT(pA, pB) PARTICLE_PROFILE_CONCAT_INNER(pA, pB)
+
+    // adds pAmount to a counter of the frame
+  #define PARTICLE_PROFILE_COUNT(pProfile, pCounter, pAmount) (pProfile).Count(pCounter, pAmount)
+    // times the rest of the scope as a phase of the frame
+  #define PARTICLE_PROFILE_PHASE(pProfile, pPhase) \
+    particlePhaseTimer PARTICLE_PROFILE_CONCAT(phaseTimer, __LINE__)(pProfile, pPhase)
+    // times the rest of the scope as the whole frame, the frame ends with the scope
+  #define PARTICLE_PROFILE_FRAME(pProfile, pBundle) \
+    particleFrameTimer PARTICLE_PROFILE_CONCAT(frameTimer, __LINE__)(pProfile, pBundle)
+#else
+  #define PARTICLE_PROFILE_COUNT(pProfile, pCounter, pAmount) ((void)0)
+  #define PARTICLE_PROFILE_PHASE(pProfile, pPhase) ((void)0)
+  #define PARTICLE_PROFILE_FRAME(pProfile, pBundle) ((void)0)
+#endif
+
+#ifdef PARTICLE_PROFILING
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// forward declarations
+class particleEmitterBundle;
+
+/*!*************************************************************************************
+\par enum: particleCounter
+\brief   Things that are counted for every emitter
+
+\par baseClass: true
+***************************************************************************************/
+enum particleCounter
+{
+  pc_spawns,          //!< particles spawned
+  pc_deaths,          //!< particles that died
+  pc_swaps,           //!< particles swapped or moved to keep the active ones contiguous
+  pc_collisionTests,  //!< particles checked against a collider (after the bounds test)
+  pc_collisionHits,   //!< particles bounced off a collider
+  pc_counterCount     //!< number of counters
+};
+
+/*!*************************************************************************************
+\par enum: particlePhase
+\brief   Parts of an emitter's update that are timed
+
+\par baseClass: true
+***************************************************************************************/
+enum particlePhase
+{
+  pp_spawn,       //!< spawning new particles
+  pp_integrate,   //!< lifetimes, physics, colors and scales of the particles
+  pp_collision,   //!< colliders and pushes between particles
+  pp_phaseCount   //!< number of phases
+};
+
+/*!*************************************************************************************
+\par struct: particleFrameStats
+\brief   Counters and phase times of one frame of an emitter (or the sum of several)
+
+\par baseClass: true
+***************************************************************************************/
+struct particleFrameStats
+{
+  /*!***********************************************************************************
+  \brief  constructor for empty stats
+  *************************************************************************************/
+  particleFrameStats();
+
+  /*!***********************************************************************************
+  \brief  Adds other stats to these
+
+  \param pOther - stats to add
+  \return these stats
+  *************************************************************************************/
+  particleFrameStats& operator+=(const particleFrameStats& pOther);
+
+  /*!***********************************************************************************
+  \brief  Gets the name of a counter
+
+  \param pCounter - counter to get the name of
+  \return name of the counter
+  *************************************************************************************/
+  static const char* GetCounterName(particleCounter pCounter);
+
+  /*!***********************************************************************************
+  \brief  Gets the name of a phase
+
+  \param pPhase - phase to get the name of
+  \return name of the phase
+  *************************************************************************************/
+  static const char* GetPhaseName(particlePhase pPhase);
+
+  unsigned m_counters[pc_counterCount]; //!< value of every counter
+  double m_phaseTimes[pp_phaseCount];   //!< seconds spent in every phase (added up over all threads running it)
+  double m_frameTime;                   //!< seconds the update took on the thread running it
+  unsigned m_frameCount;                //!< number of frames added up
+};
+
+/*!*************************************************************************************
+\par class: particleEmitterProfile
+\brief  Collects the counters and phase times of an emitter while it updates. Phases
+        running in chunks on the job system add to it from several threads at once.
+\par baseClass: true
+***************************************************************************************/
+class particleEmitterProfile
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for the profile
+
+  \param pName - name of the emitter, shown in the trace
+  *************************************************************************************/
+  explicit particleEmitterProfile(const std::string& pName);
+
+  /*!***********************************************************************************
+  \brief  copy constructor for the profile. The copy is another emitter, so it gets an
+          id of its own and starts without stats.
+
+  \param pOther - profile to copy the name of
+  *************************************************************************************/
+  particleEmitterProfile(const particleEmitterProfile& pOther);
+
+  /*!***********************************************************************************
+  \brief  assignment operator for the profile, keeps its own id and stats
+
+  \param pOther - profile being assigned
+  \return this profile
+  *************************************************************************************/
+  particleEmitterProfile& operator=(const particleEmitterProfile& pOther);
+
+  /*!***********************************************************************************
+  \brief  Adds to a counter of the current frame
+
+  \param pCounter - counter to add to
+  \param pAmount - amount to add
+  *************************************************************************************/
+  void Count(particleCounter pCounter, unsigned pAmount);
+
+  /*!***********************************************************************************
+  \brief  Adds the time spent in a phase to the current frame
+
+  \param pPhase - phase that ran
+  \param pStart - time the phase started (particleProfiler::GetTime)
+  \param pEnd - time the phase ended
+  *************************************************************************************/
+  void AddPhaseTime(particlePhase pPhase, long long pStart, long long pEnd);
+
+  /*!***********************************************************************************
+  \brief  Ends the current frame. Its stats become the last frame's and are added to the
+          emitter's bundle.
+
+  \param pBundle - bundle the emitter belongs to (can be null)
+  \param pStart - time the update started
+  \param pEnd - time the update ended
+  *************************************************************************************/
+  void EndFrame(const particleEmitterBundle* pBundle, long long pStart, long long pEnd);
+
+  /*!***********************************************************************************
+  \brief  Gets the stats of the last frame the emitter updated in
+
+  \return stats of the last frame
+  *************************************************************************************/
+  const particleFrameStats& GetLastFrame() const;
+
+  /*!***********************************************************************************
+  \brief  Gets the id of the emitter in the trace
+
+  \return id of the emitter
+  *************************************************************************************/
+  unsigned GetId() const;
+
+private:
+  std::atomic<unsigned> m_counters[pc_counterCount]; //!< counters of the current frame
+  std::atomic<long long> m_phaseTimes[pp_phaseCount]; //!< nanoseconds spent in every phase this frame
+  particleFrameStats m_lastFrame;                     //!< stats of the last finished frame
+  std::string m_name;                                 //!< name of the emitter
+  unsigned m_id;                                      //!< id of the emitter in the trace
+};
+
+/*!*************************************************************************************
+\par class: particleProfiler
+\brief  Adds up the stats of the emitters per bundle and records the timeline of their
+        updates and phases for the Chrome trace. Emitters update on several threads, so
+        everything recorded goes through a lock (it's only there in profiling builds).
+\par baseClass: true
+***************************************************************************************/
+class particleProfiler
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for the profiler
+  *************************************************************************************/
+  particleProfiler();
+
+  particleProfiler(const particleProfiler&) = delete;
+  particleProfiler& operator=(const particleProfiler&) = delete;
+
+  /*!***********************************************************************************
+  \brief  Starts a new frame, the stats of the bundles start over
+  *************************************************************************************/
+  void BeginFrame();
+
+  /*!***********************************************************************************
+  \brief  Gets the stats of a bundle since the frame began
+
+  \param pBundle - bundle to get the stats of (null for emitters without one)
+  \return stats of all emitters in the bundle added up
+  *************************************************************************************/
+  particleFrameStats GetBundleStats(const particleEmitterBundle* pBundle) const;
+
+  /*!***********************************************************************************
+  \brief  Gets the stats of all emitters since the frame began
+
+  \return stats of all emitters added up
+  *************************************************************************************/
+  particleFrameStats GetTotalStats() const;
+
+  /*!***********************************************************************************
+  \brief  Starts or stops recording the timeline for the trace
+
+  \param pIsTracing - if the timeline is recorded
+  *************************************************************************************/
+  void SetTracing(bool pIsTracing);
+
+  /*!***********************************************************************************
+  \brief  Throws away the recorded timeline
+  *************************************************************************************/
+  void ClearTrace();
+
+  /*!***********************************************************************************
+  \brief  Writes the recorded timeline in the Chrome trace event format (JSON, opens in
+          chrome://tracing). Every update and phase is a slice on the thread that ran
+          it, the counters of every update are a counter track per emitter.
+
+  \param pStream - stream to write the trace to
+  *************************************************************************************/
+  void WriteChromeTrace(std::ostream& pStream) const;
+
+  /*!***********************************************************************************
+  \brief  Writes the recorded timeline to a file, see WriteChromeTrace
+
+  \param pPath - path of the file
+  \return false if the file couldn't be written
+  *************************************************************************************/
+  bool WriteChromeTrace(const char* pPath) const;
+
+  /*!***********************************************************************************
+  \brief  Gives an emitter an id for the trace
+
+  \param pName - name of the emitter
+  \return id of the emitter
+  *************************************************************************************/
+  unsigned RegisterEmitter(const std::string& pName);
+
+  /*!***********************************************************************************
+  \brief  Records a phase of an emitter on the timeline (if tracing)
+
+  \param pEmitterId - id of the emitter
+  \param pPhase - phase that ran
+  \param pStart - time the phase started
+  \param pEnd - time the phase ended
+  *************************************************************************************/
+  void RecordPhase(unsigned pEmitterId, particlePhase pPhase, long long pStart, long long pEnd);
+
+  /*!***********************************************************************************
+  \brief  Records a finished frame of an emitter, adds it to its bundle and puts it on
+          the timeline (if tracing)
+
+  \param pEmitterId - id of the emitter
+  \param pBundle - bundle the emitter belongs to (can be null)
+  \param pStats - stats of the frame
+  \param pStart - time the update started
+  \param pEnd - time the update ended
+  *************************************************************************************/
+  void RecordFrame(unsigned pEmitterId, const particleEmitterBundle* pBundle, const particleFrameStats& pStats, long long pStart, long long pEnd);
+
+  /*!***********************************************************************************
+  \brief  Gets the current time for the profiler
+
+  \return nanoseconds since some fixed point
+  *************************************************************************************/
+  static long long GetTime();
+
+  /*!***********************************************************************************
+  \brief  Gets the profiler all emitters report to
+
+  \return global profiler
+  *************************************************************************************/
+  static particleProfiler& GetGlobalProfiler();
+
+  static const unsigned c_maxTraceEvents = 1 << 20; //!< events recorded before the trace stops growing
+
+private:
+  /*!***********************************************************************************
+  \brief  a slice on the timeline, a phase or a whole frame of an emitter
+  *************************************************************************************/
+  struct traceEvent
+  {
+    long long m_start;     //!< time the slice started
+    long long m_end;       //!< time the slice ended
+    unsigned m_emitterId;  //!< emitter the slice belongs to
+    unsigned m_threadId;   //!< thread the slice ran on
+    int m_phase;           //!< phase of the slice (pp_phaseCount for a whole frame)
+    unsigned m_frameStats; //!< index of the frame's stats (for a whole frame)
+  };
+
+  /*!***********************************************************************************
+  \brief  Gets a small id for the calling thread (needs the lock)
+
+  \return id of the thread
+  *************************************************************************************/
+  unsigned GetThreadId();
+
+  /*!***********************************************************************************
+  \brief  Adds an event to the timeline (needs the lock)
+
+  \return if there was room for the event
+  *************************************************************************************/
+  bool PushEvent(const traceEvent& pEvent);
+
+  mutable std::mutex m_mutex;  //!< emitters report from several threads
+  bool m_isTracing;            //!< if the timeline is recorded
+  long long m_traceStart;      //!< time the trace started (the timeline starts at 0)
+  unsigned m_droppedEvents;    //!< events that didn't fit in the trace
+
+  std::unordered_map<const particleEmitterBundle*, particleFrameStats> m_bundleStats; //!< stats of every bundle this frame
+  std::unordered_map<std::thread::id, unsigned> m_threadIds;                          //!< small id of every thread seen
+  std::vector<std::string> m_emitterNames;                                            //!< name of every emitter by id
+  std::vector<traceEvent> m_events;                                                   //!< recorded timeline
+  std::vector<particleFrameStats> m_frameStats;                                       //!< stats of the frames on the timeline
+};
+
+/*!*************************************************************************************
+\par class: particlePhaseTimer
+\brief  Times a scope as a phase of an emitter (PARTICLE_PROFILE_PHASE)
+\par baseClass: true
+***************************************************************************************/
+class particlePhaseTimer
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for the timer, starts it
+
+  \param pProfile - profile of the emitter
+  \param pPhase - phase being timed
+  *************************************************************************************/
+  particlePhaseTimer(particleEmitterProfile& pProfile, particlePhase pPhase);
+
+  /*!***********************************************************************************
+  \brief  destructor for the timer, adds the time to the profile
+  *************************************************************************************/
+  ~particlePhaseTimer();
+
+  particlePhaseTimer(const particlePhaseTimer&) = delete;
+  particlePhaseTimer& operator=(const particlePhaseTimer&) = delete;
+
+private:
+  particleEmitterProfile& m_profile; //!< profile of the emitter
+  particlePhase m_phase;             //!< phase being timed
+  long long m_start;                 //!< time the timer started
+};
+
+/*!*************************************************************************************
+\par class: particleFrameTimer
+\brief  Times a scope as a whole frame of an emitter and ends the frame with it
+        (PARTICLE_PROFILE_FRAME)
+\par baseClass: true
+***************************************************************************************/
+class particleFrameTimer
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for the timer, starts it
+
+  \param pProfile - profile of the emitter
+  \param pBundle - bundle the emitter belongs to (can be null)
+  *************************************************************************************/
+  particleFrameTimer(particleEmitterProfile& pProfile, const particleEmitterBundle* pBundle);
+
+  /*!***********************************************************************************
+  \brief  destructor for the timer, ends the frame
+  *************************************************************************************/
+  ~particleFrameTimer();
+
+  particleFrameTimer(const particleFrameTimer&) = delete;
+  particleFrameTimer& operator=(const particleFrameTimer&) = delete;
+
+private:
+  particleEmitterProfile& m_profile;      //!< profile of the emitter
+  const particleEmitterBundle* m_bundle;  //!< bundle the emitter belongs to
+  long long m_start;                      //!< time the timer started
+};
+
+#endif
@@ -0,0 +1,173 @@
+/*!****************************************************************************************
+\file       ParticleRandom.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particleRandom class.
+******************************************************************************************/
+
+#include "ParticleRandom.h"
+#include <atomic>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define PARTICLE_RANDOM_SSE2
+  #include <emmintrin.h>
+#endif
+
+namespace
+{
+  const float c_floatUnit = 1.0f / 16777216.0f; //!< 2^-24, turns the top 24 bits into [0, 1)
+
+  /*!***********************************************************************************
+  \brief  splitmix64, used to spread a seed over the state of the generators
+  *************************************************************************************/
+  std::uint64_t SplitMix(std::uint64_t& pState)
+  {
+    std::uint64_t z = (pState += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  /*!***********************************************************************************
+  \brief  turns a random number into a float in [pMin, pMin + pRange)
+  *************************************************************************************/
+  float ToRange(std::uint32_t pValue, float pMin, float pRange)
+  {
+    float unit = static_cast<float>(static_cast<std::int32_t>(pValue >> 8)) * c_floatUnit;
+    return pMin + pRange * unit;
+  }
+}
+
+particleRandom::particleRandom(std::uint64_t pSeed)
+{
+  Seed(pSeed);
+}
+
+void particleRandom::Seed(std::uint64_t pSeed)
+{
+  std::uint64_t seedState = pSeed;
+
+  for (unsigned lane = 0; lane < c_laneCount; ++lane)
+  {
+    std::uint64_t first = SplitMix(seedState);
+    std::uint64_t second = SplitMix(seedState);
+
+    m_state[0][lane] = static_cast<std::uint32_t>(first);
+    m_state[1][lane] = static_cast<std::uint32_t>(first >> 32);
+    m_state[2][lane] = static_cast<std::uint32_t>(second);
+    m_state[3][lane] = static_cast<std::uint32_t>(second >> 32);
+
+      // xoshiro never leaves the all zero state
+    if (!(m_state[0][lane] | m_state[1][lane] | m_state[2][lane] | m_state[3][lane]))
+      m_state[0][lane] = 1;
+  }
+
+    // nothing buffered yet
+  m_bufferIndex = c_laneCount;
+}
+
+std::uint32_t particleRandom::Next()
+{
+  if (m_bufferIndex == c_laneCount)
+  {
+    StepLanes(m_buffer);
+    m_bufferIndex = 0;
+  }
+
+  return m_buffer[m_bufferIndex++];
+}
+
+float particleRandom::Range(float pMin, float pMax)
+{
+  return ToRange(Next(), pMin, pMax - pMin);
+}
+
+void particleRandom::FillRange(float* pValues, unsigned pCount, float pMin, float pMax)
+{
+  float range = pMax - pMin;
+  unsigned i = 0;
+
+    // handing out what's left of the last step first, so the order matches Range
+  while ((i < pCount) && (m_bufferIndex < c_laneCount))
+    pValues[i++] = ToRange(m_buffer[m_bufferIndex++], pMin, range);
+
+#if defined(PARTICLE_RANDOM_SSE2)
+  __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_state[0]));
+  __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_state[1]));
+  __m128i s2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_state[2]));
+  __m128i s3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_state[3]));
+  __m128 minimum = _mm_set1_ps(pMin);
+  __m128 scale = _mm_set1_ps(range);
+  __m128 unit = _mm_set1_ps(c_floatUnit);
+
+  for (; i + c_laneCount <= pCount; i += c_laneCount)
+  {
+    __m128i result = _mm_add_epi32(s0, s3);
+    __m128i t = _mm_slli_epi32(s1, 9);
+
+    s2 = _mm_xor_si128(s2, s0);
+    s3 = _mm_xor_si128(s3, s1);
+    s1 = _mm_xor_si128(s1, s2);
+    s0 = _mm_xor_si128(s0, s3);
+    s2 = _mm_xor_si128(s2, t);
+    s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+
+      // same math as ToRange, so both give the same bits
+    __m128 values = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(result, 8)), unit);
+    _mm_storeu_ps(pValues + i, _mm_add_ps(minimum, _mm_mul_ps(scale, values)));
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(m_state[0]), s0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(m_state[1]), s1);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(m_state[2]), s2);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(m_state[3]), s3);
+#else
+  for (; i + c_laneCount <= pCount; i += c_laneCount)
+  {
+    std::uint32_t results[c_laneCount];
+    StepLanes(results);
+
+    for (unsigned lane = 0; lane < c_laneCount; ++lane)
+      pValues[i + lane] = ToRange(results[lane], pMin, range);
+  }
+#endif
+
+    // leftovers that don't fill a whole step
+  while (i < pCount)
+    pValues[i++] = ToRange(Next(), pMin, range);
+}
+
+std::uint64_t particleRandom::GetUniqueSeed()
+{
+  static std::atomic<std::uint64_t> nextSeed(1);
+  return nextSeed++;
+}
+
+void particleRandom::StepLanes(std::uint32_t pResults[c_laneCount])
+{
+  for (unsigned lane = 0; lane < c_laneCount; ++lane)
+  {
+    std::uint32_t s0 = m_state[0][lane];
+    std::uint32_t s1 = m_state[1][lane];
+    std::uint32_t s2 = m_state[2][lane];
+    std::uint32_t s3 = m_state[3][lane];
+
+    pResults[lane] = s0 + s3;
+    std::uint32_t t = s1 << 9;
+
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = (s3 << 11) | (s3 >> 21);
+
+    m_state[0][lane] = s0;
+    m_state[1][lane] = s1;
+    m_state[2][lane] = s2;
+    m_state[3][lane] = s3;
+  }
+}
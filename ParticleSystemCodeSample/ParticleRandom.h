@@ -0,0 +1,91 @@
+/*!****************************************************************************************
+\file       ParticleRandom.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particleRandom class. Every emitter owns one, so emitters
+can spawn particles on different threads and the same seed always gives the same
+particles.
+******************************************************************************************/
+#pragma once
+#include <cstdint>
+
+/*!*************************************************************************************
+\par class: particleRandom
+
+\brief  Seedable random number stream made of 4 xoshiro128+ generators running side by
+        side, so 4 numbers can be generated with a single SSE2 step. Numbers are handed
+        out lane by lane, so filling an array gives exactly the same numbers as asking
+        for them one at a time. Only integer math is used to generate them, so a seed
+        gives bit identical numbers on every machine.
+\par baseClass: true
+***************************************************************************************/
+class particleRandom
+{
+public:
+  /*!***********************************************************************************
+  \brief  constructor for the random stream
+
+  \param pSeed - seed for the stream
+  *************************************************************************************/
+  explicit particleRandom(std::uint64_t pSeed = 0);
+
+  /*!***********************************************************************************
+  \brief  Restarts the stream from a seed
+
+  \param pSeed - seed for the stream
+  *************************************************************************************/
+  void Seed(std::uint64_t pSeed);
+
+  /*!***********************************************************************************
+  \brief  Gets the next random number
+
+  \return random number in [0, 2^32)
+  *************************************************************************************/
+  std::uint32_t Next();
+
+  /*!***********************************************************************************
+  \brief  Gets the next random float in a range
+
+  \param pMin - smallest value
+  \param pMax - biggest value (never returned)
+  \return random float in [pMin, pMax)
+  *************************************************************************************/
+  float Range(float pMin, float pMax);
+
+  /*!***********************************************************************************
+  \brief  Fills an array with random floats in a range (same numbers as calling Range
+          pCount times, just faster)
+
+  \param pValues - array to fill
+  \param pCount - number of values to fill
+  \param pMin - smallest value
+  \param pMax - biggest value (never returned)
+  *************************************************************************************/
+  void FillRange(float* pValues, unsigned pCount, float pMin, float pMax);
+
+  /*!***********************************************************************************
+  \brief  Gets a seed nobody else got yet, for emitters that weren't given a seed. The
+          seeds are handed out in order, so emitters created in the same order get the
+          same seeds every run.
+
+  \return new seed
+  *************************************************************************************/
+  static std::uint64_t GetUniqueSeed();
+
+  static const unsigned c_laneCount = 4; //!< number of generators running side by side
+
+private:
+  /*!***********************************************************************************
+  \brief  Steps every generator once
+
+  \param pResults - filled with the number of every generator
+  *************************************************************************************/
+  void StepLanes(std::uint32_t pResults[c_laneCount]);
+
+  std::uint32_t m_state[4][c_laneCount];  //!< xoshiro128+ state (4 words) of every generator
+  std::uint32_t m_buffer[c_laneCount];    //!< numbers of the last step not handed out yet
+  unsigned m_bufferIndex;                 //!< next number of the buffer to hand out
+};
@@ -0,0 +1,225 @@
+/*!****************************************************************************************
+\file       ParticleStorage.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the implementation for the particleStorage struct.
+******************************************************************************************/
+
+#include "ParticleStorage.h"
+#include "Particle.h"
+#include "ParticleArena.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // every array holding one float per particle
+  float* particleStorage::* const c_floatArrays[] =
+  {
+    &particleStorage::m_positionX, &particleStorage::m_positionY, &particleStorage::m_positionZ,
+    &particleStorage::m_oldPositionX, &particleStorage::m_oldPositionY,
+    &particleStorage::m_velocityX, &particleStorage::m_velocityY,
+    &particleStorage::m_forceX, &particleStorage::m_forceY,
+    &particleStorage::m_rotation, &particleStorage::m_angularVelocity,
+    &particleStorage::m_currentLifetime, &particleStorage::m_totalLifetime,
+    &particleStorage::m_scale,
+    &particleStorage::m_colorR, &particleStorage::m_colorG, &particleStorage::m_colorB, &particleStorage::m_colorA
+  };
+
+  /*!***********************************************************************************
+  \brief  rounds a size up so the next array starts on a cache line
+  *************************************************************************************/
+  std::size_t AlignSize(std::size_t pSize)
+  {
+    return (pSize + particleArena::c_alignment - 1) & ~(particleArena::c_alignment - 1);
+  }
+
+  /*!***********************************************************************************
+  \brief  takes an array out of the block and moves the cursor past it
+  *************************************************************************************/
+  template <typename T>
+  T* CarveArray(char*& pCursor, std::size_t pCount)
+  {
+    T* values = reinterpret_cast<T*>(pCursor);
+    pCursor += AlignSize(pCount * sizeof(T));
+    return values;
+  }
+}
+
+particleStorage::particleStorage() : m_arena(nullptr), m_block(nullptr), m_blockSize(0), m_capacity(0)
+{
+  Allocate(0);
+}
+
+particleStorage::particleStorage(unsigned pCapacity, particleArena* pArena) :
+  m_arena(pArena ? pArena : &particleArena::GetGlobalArena()), m_block(nullptr), m_blockSize(0), m_capacity(0)
+{
+  Allocate(pCapacity);
+
+    // every particle starts out inactive, with a scale of 1 and an opaque color
+  for (auto floatArray : c_floatArrays)
+    std::fill(this->*floatArray, this->*floatArray + m_capacity, 0.0f);
+
+  std::fill(m_randomScale, m_randomScale + m_capacity * 2, 1.0f);
+  std::fill(m_scale, m_scale + m_capacity, 1.0f);
+  std::fill(m_colorA, m_colorA + m_capacity, 1.0f);
+  std::fill(m_isActive, m_isActive + m_capacity, static_cast<unsigned char>(false));
+}
+
+particleStorage::particleStorage(const particleStorage& pOther) :
+  m_arena(pOther.m_arena), m_block(nullptr), m_blockSize(0), m_capacity(0)
+{
+  Allocate(pOther.m_capacity);
+
+    // both blocks have the same layout
+  if (m_block)
+    std::memcpy(m_block, pOther.m_block, m_blockSize);
+  m_moveCount = pOther.m_moveCount;
+}
+
+particleStorage::particleStorage(particleStorage&& pOther) :
+  m_arena(nullptr), m_block(nullptr), m_blockSize(0), m_capacity(0)
+{
+  Allocate(0);
+  TakeOver(pOther);
+}
+
+particleStorage::~particleStorage()
+{
+  Release();
+}
+
+particleStorage& particleStorage::operator=(const particleStorage& pOther)
+{
+  if (this != &pOther)
+  {
+    particleStorage copy(pOther);
+    Release();
+    TakeOver(copy);
+  }
+
+  return *this;
+}
+
+particleStorage& particleStorage::operator=(particleStorage&& pOther)
+{
+  if (this != &pOther)
+  {
+    Release();
+    TakeOver(pOther);
+  }
+
+  return *this;
+}
+
+void particleStorage::CopyParticles(const particleStorage& pSource, unsigned pCount)
+{
+    // an empty storage has no arrays to copy from
+  if (!pCount)
+    return;
+
+  for (auto floatArray : c_floatArrays)
+    std::memcpy(this->*floatArray, pSource.*floatArray, pCount * sizeof(float));
+
+  std::memcpy(m_randomScale, pSource.m_randomScale, pCount * 2 * sizeof(float));
+  std::memcpy(m_isActive, pSource.m_isActive, pCount);
+}
+
+void particleStorage::ApplyMoves(const particleMove* pMoves, unsigned pMoveCount)
+{
+  for (auto floatArray : c_floatArrays)
+  {
+    float* values = this->*floatArray;
+    for (unsigned i = 0; i < pMoveCount; ++i)
+      values[pMoves[i].m_to] = values[pMoves[i].m_from];
+  }
+
+    // scales are stored in pairs
+  for (unsigned i = 0; i < pMoveCount; ++i)
+  {
+    m_randomScale[pMoves[i].m_to * 2] = m_randomScale[pMoves[i].m_from * 2];
+    m_randomScale[pMoves[i].m_to * 2 + 1] = m_randomScale[pMoves[i].m_from * 2 + 1];
+  }
+}
+
+void particleStorage::Rotate(unsigned pFirst)
+{
+  if (!pFirst)
+    return;
+
+  for (auto floatArray : c_floatArrays)
+    std::rotate(this->*floatArray, this->*floatArray + pFirst, this->*floatArray + m_capacity);
+
+  std::rotate(m_randomScale, m_randomScale + pFirst * 2, m_randomScale + m_capacity * 2);
+  std::rotate(m_isActive, m_isActive + pFirst, m_isActive + m_capacity);
+}
+
+unsigned particleStorage::size() const
+{
+  return m_capacity;
+}
+
+particleArena* particleStorage::GetArena() const
+{
+  return m_arena;
+}
+
+particle particleStorage::operator[](unsigned pIndex)
+{
+  return particle(*this, pIndex);
+}
+
+void particleStorage::Allocate(unsigned pCapacity)
+{
+  const std::size_t floatArrayCount = sizeof(c_floatArrays) / sizeof(c_floatArrays[0]);
+
+  m_capacity = pCapacity;
+  m_blockSize = AlignSize(pCapacity * sizeof(float)) * floatArrayCount
+              + AlignSize(pCapacity * 2 * sizeof(float))
+              + AlignSize(pCapacity * sizeof(unsigned char))
+              + AlignSize(pCapacity * sizeof(particleMove));
+  m_block = (m_blockSize && m_arena) ? m_arena->Allocate(m_blockSize) : nullptr;
+  m_moveCount = 0;
+
+    // pointing every array into the block
+  char* cursor = static_cast<char*>(m_block);
+  for (auto floatArray : c_floatArrays)
+    this->*floatArray = m_block ? CarveArray<float>(cursor, pCapacity) : nullptr;
+
+  m_randomScale = m_block ? CarveArray<float>(cursor, pCapacity * 2) : nullptr;
+  m_isActive = m_block ? CarveArray<unsigned char>(cursor, pCapacity) : nullptr;
+  m_moves = m_block ? CarveArray<particleMove>(cursor, pCapacity) : nullptr;
+}
+
+void particleStorage::Release()
+{
+  if (m_block)
+    m_arena->Free(m_block, m_blockSize);
+
+  m_block = nullptr;
+  m_blockSize = 0;
+  Allocate(0);
+}
+
+void particleStorage::TakeOver(particleStorage& pOther)
+{
+  for (auto floatArray : c_floatArrays)
+    this->*floatArray = pOther.*floatArray;
+
+  m_randomScale = pOther.m_randomScale;
+  m_isActive = pOther.m_isActive;
+  m_moves = pOther.m_moves;
+  m_moveCount = pOther.m_moveCount;
+  m_arena = pOther.m_arena;
+  m_block = pOther.m_block;
+  m_blockSize = pOther.m_blockSize;
+  m_capacity = pOther.m_capacity;
+
+    // leaving the other storage empty
+  pOther.m_block = nullptr;
+  pOther.m_blockSize = 0;
+  pOther.Allocate(0);
+}
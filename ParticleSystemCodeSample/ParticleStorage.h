@@ -0,0 +1,187 @@
+/*!****************************************************************************************
+\file       ParticleStorage.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+This is the interface for the particleStorage struct. The particle data of an emitter is
+stored as a structure of arrays so the update can walk each attribute linearly. All the
+arrays live in a single block of a particle arena.
+******************************************************************************************/
+#pragma once
+#include <cstddef>
+
+// forward declarations
+class particle;
+class particleArena;
+
+/*!*************************************************************************************
+\par struct: particleMove
+\brief   A particle being moved from one slot of the storage into another
+
+\par baseClass: true
+***************************************************************************************/
+struct particleMove
+{
+  unsigned m_from; //!< index the particle is moved from
+  unsigned m_to;   //!< index the particle is moved to (its old data is overwritten)
+};
+
+/*!*************************************************************************************
+\par struct: particleSpan
+\brief   A contiguous range of particles [m_begin, m_end) in the storage
+
+\par baseClass: true
+***************************************************************************************/
+struct particleSpan
+{
+  unsigned m_begin; //!< index of the first particle
+  unsigned m_end;   //!< one past the index of the last particle
+};
+
+/*!*************************************************************************************
+\par struct: particleStorage
+\brief   Structure of arrays holding every particle of an emitter. Every array is kept
+  in lockstep, so index i in each of them belongs to the same particle. The index is
+  also the particle's slot in the emitter's vector of gpu data. The capacity is fixed
+  when the storage is created and all arrays share one block of arena memory.
+
+\par baseClass: true
+***************************************************************************************/
+struct particleStorage
+{
+  /*!************************************************************************************
+  \brief  constructor for an empty storage
+  **************************************************************************************/
+  particleStorage();
+
+  /*!************************************************************************************
+  \brief  constructor for the storage, allocates room for all the particles up front.
+          Every particle starts out inactive.
+
+  \param pCapacity - number of particles the storage can hold
+  \param pArena - arena to allocate from (nullptr for the global arena)
+  **************************************************************************************/
+  particleStorage(unsigned pCapacity, particleArena* pArena);
+
+  /*!************************************************************************************
+  \brief  copy constructor, allocates from the same arena as pOther
+  **************************************************************************************/
+  particleStorage(const particleStorage& pOther);
+
+  /*!************************************************************************************
+  \brief  move constructor, takes over the memory of pOther
+  **************************************************************************************/
+  particleStorage(particleStorage&& pOther);
+
+  /*!************************************************************************************
+  \brief  destructor, gives the memory back to the arena
+  **************************************************************************************/
+  ~particleStorage();
+
+  particleStorage& operator=(const particleStorage& pOther);
+  particleStorage& operator=(particleStorage&& pOther);
+
+  /*!************************************************************************************
+  \brief  Copies the first particles of another storage into this one
+
+  \param pSource - storage to copy from
+  \param pCount - number of particles to copy (from index 0)
+  **************************************************************************************/
+  void CopyParticles(const particleStorage& pSource, unsigned pCount);
+
+  /*!************************************************************************************
+  \brief  Moves particles into other slots, one array at a time. The activity flags are
+          left alone, they're the caller's job.
+
+  \param pMoves - list of particles to move
+  \param pMoveCount - number of moves in the list
+  **************************************************************************************/
+  void ApplyMoves(const particleMove* pMoves, unsigned pMoveCount);
+
+  /*!************************************************************************************
+  \brief  Rotates every array so the given particle ends up at index 0 (used to turn a
+          ring buffer back into a plain array)
+
+  \param pFirst - index of the particle that becomes the first one
+  **************************************************************************************/
+  void Rotate(unsigned pFirst);
+
+  /*!************************************************************************************
+  \brief  Gets the number of particles in the storage (active and inactive)
+
+  \return number of particles
+  **************************************************************************************/
+  unsigned size() const;
+
+  /*!************************************************************************************
+  \brief  Gets the arena the storage allocates from
+
+  \return arena
+  **************************************************************************************/
+  particleArena* GetArena() const;
+
+  /*!************************************************************************************
+  \brief  Gets a lightweight view of a single particle in the storage
+
+  \param pIndex - index of the particle
+  \return particle view referring to the index
+  **************************************************************************************/
+  particle operator[](unsigned pIndex);
+
+  float* m_positionX; //!< x position of the particle
+  float* m_positionY; //!< y position of the particle
+  float* m_positionZ; //!< z position of the particle (never integrated)
+
+  float* m_oldPositionX; //!< x position before the last physics update
+  float* m_oldPositionY; //!< y position before the last physics update
+
+  float* m_velocityX; //!< x velocity of the particle
+  float* m_velocityY; //!< y velocity of the particle
+
+  float* m_forceX; //!< x force of the individual particle (cleared every update)
+  float* m_forceY; //!< y force of the individual particle (cleared every update)
+
+  float* m_rotation;        //!< current rotation of the particle
+  float* m_angularVelocity; //!< current angular velocity of the particle
+
+  float* m_currentLifetime; //!< particle's current lifetime
+  float* m_totalLifetime;   //!< total lifetime of the particle
+
+  float* m_randomScale; //!< pairs of random initial and final scale (2 per particle)
+  float* m_scale;       //!< current scale of the particle
+
+  float* m_colorR; //!< red of the particle's current color
+  float* m_colorG; //!< green of the particle's current color
+  float* m_colorB; //!< blue of the particle's current color
+  float* m_colorA; //!< alpha of the particle's current color
+
+  unsigned char* m_isActive; //!< if the particle is active or not
+
+  particleMove* m_moves; //!< moves made by the last compaction (room for one per particle)
+  unsigned m_moveCount;  //!< number of moves made by the last compaction
+
+private:
+  /*!************************************************************************************
+  \brief  Gets a block from the arena and points every array into it
+
+  \param pCapacity - number of particles to make room for
+  **************************************************************************************/
+  void Allocate(unsigned pCapacity);
+
+  /*!************************************************************************************
+  \brief  Gives the block back to the arena
+  **************************************************************************************/
+  void Release();
+
+  /*!************************************************************************************
+  \brief  Takes over the memory of another storage and leaves it empty
+  **************************************************************************************/
+  void TakeOver(particleStorage& pOther);
+
+  particleArena* m_arena;    //!< arena the block comes from
+  void* m_block;             //!< block holding all the arrays
+  std::size_t m_blockSize;   //!< size of the block in bytes
+  unsigned m_capacity;       //!< number of particles the storage holds
+};
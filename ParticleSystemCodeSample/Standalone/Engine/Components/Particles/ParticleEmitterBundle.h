@@ -0,0 +1,14 @@
+/*!****************************************************************************************
+\file       ParticleEmitterBundle.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's emitter bundle, the particle system only holds pointers to
+it. Part of the standalone build of the particle system.
+******************************************************************************************/
+#pragma once
+
+// forward declarations
+class particleEmitterBundle;
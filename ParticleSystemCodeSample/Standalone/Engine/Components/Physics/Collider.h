@@ -0,0 +1,83 @@
+/*!****************************************************************************************
+\file       Collider.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's colliders and their shapes. Part of the standalone build of
+the particle system.
+******************************************************************************************/
+#pragma once
+
+#include <vector>
+#include "../../../Math/Vector4.h"
+
+// forward declarations
+class physics;
+
+/*!*************************************************************************************
+\par class: shape
+\brief  Shape of a collider
+
+\par baseClass: true
+***************************************************************************************/
+class shape
+{
+public:
+  virtual ~shape() {}
+};
+
+/*!*************************************************************************************
+\par class: polygon
+\brief  Convex polygon, the normal of face i goes with the edge from vertex i to i + 1
+
+\par baseClass: false
+***************************************************************************************/
+class polygon : public shape
+{
+public:
+  const std::vector<vector4>& GetVertexList() const { return m_vertices; }
+  const std::vector<vector4>& GetNormalList() const { return m_normals; }
+
+  std::vector<vector4> m_vertices; //!< vertices in local space
+  std::vector<vector4> m_normals;  //!< outward normal of every face
+};
+
+/*!*************************************************************************************
+\par class: circle
+\brief  Circle around the collider's position
+
+\par baseClass: false
+***************************************************************************************/
+class circle : public shape
+{
+public:
+  float GetRadius() const { return m_radius; }
+
+  float m_radius = 1.0f; //!< radius in local space
+};
+
+/*!*************************************************************************************
+\par class: collider
+\brief  Collider of an object
+
+\par baseClass: true
+***************************************************************************************/
+class collider
+{
+public:
+  enum colliderType
+  {
+    ct_circle,
+    ct_polygon
+  };
+
+  virtual ~collider() {}
+  virtual colliderType GetType() const = 0;
+  virtual shape& GetColliderShape() = 0;
+
+  physics* GetPhysicsComponent() { return m_physics; }
+
+  physics* m_physics = nullptr; //!< physics component of the object
+};
@@ -0,0 +1,28 @@
+/*!****************************************************************************************
+\file       ColliderCircle.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's circle collider. Part of the standalone build of the
+particle system.
+******************************************************************************************/
+#pragma once
+
+#include "Collider.h"
+
+/*!*************************************************************************************
+\par class: colliderCircle
+\brief  Collider shaped like a circle
+
+\par baseClass: false
+***************************************************************************************/
+class colliderCircle : public collider
+{
+public:
+  colliderType GetType() const override { return ct_circle; }
+  shape& GetColliderShape() override { return m_circle; }
+
+  circle m_circle; //!< shape of the collider
+};
@@ -0,0 +1,28 @@
+/*!****************************************************************************************
+\file       ColliderPolygon.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's polygon collider. Part of the standalone build of the
+particle system.
+******************************************************************************************/
+#pragma once
+
+#include "Collider.h"
+
+/*!*************************************************************************************
+\par class: colliderPolygon
+\brief  Collider shaped like a convex polygon
+
+\par baseClass: false
+***************************************************************************************/
+class colliderPolygon : public collider
+{
+public:
+  colliderType GetType() const override { return ct_polygon; }
+  shape& GetColliderShape() override { return m_polygon; }
+
+  polygon m_polygon; //!< shape of the collider
+};
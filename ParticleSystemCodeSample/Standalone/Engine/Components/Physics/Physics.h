@@ -0,0 +1,27 @@
+/*!****************************************************************************************
+\file       Physics.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's physics component. Part of the standalone build of the
+particle system.
+******************************************************************************************/
+#pragma once
+
+#include "RigidBody.h"
+
+/*!*************************************************************************************
+\par class: physics
+\brief  Physics component of an object
+
+\par baseClass: true
+***************************************************************************************/
+class physics
+{
+public:
+  rigidBody* GetRigidBodyComponent() { return &m_rigidBody; }
+
+  rigidBody m_rigidBody; //!< rigid body of the object
+};
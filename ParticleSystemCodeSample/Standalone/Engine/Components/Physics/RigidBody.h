@@ -0,0 +1,27 @@
+/*!****************************************************************************************
+\file       RigidBody.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's rigid body. Part of the standalone build of the particle
+system.
+******************************************************************************************/
+#pragma once
+
+#include "../../../Math/Vector4.h"
+
+/*!*************************************************************************************
+\par class: rigidBody
+\brief  Motion of a physics object
+
+\par baseClass: true
+***************************************************************************************/
+class rigidBody
+{
+public:
+  vector4 GetVelocity() const { return m_velocity; }
+
+  vector4 m_velocity; //!< velocity of the object
+};
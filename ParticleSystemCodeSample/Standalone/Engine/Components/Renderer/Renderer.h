@@ -0,0 +1,42 @@
+/*!****************************************************************************************
+\file       Renderer.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's renderer, only the types the particle system hands its gpu
+data over in. Part of the standalone build of the particle system.
+******************************************************************************************/
+#pragma once
+
+#include <string>
+#include "../Transform.h"
+
+/*!*************************************************************************************
+\par class: shaderHandler
+\brief  Holds the layout of the data the particle shader reads
+
+\par baseClass: true
+***************************************************************************************/
+class shaderHandler
+{
+public:
+  struct gPUData
+  {
+    transform m_particleTransform; //!< final transform of the particle
+    vector4 m_particleColor;       //!< final color of the particle
+  };
+};
+
+/*!*************************************************************************************
+\par class: renderer
+\brief  Graphics settings of an emitter
+
+\par baseClass: true
+***************************************************************************************/
+class renderer
+{
+public:
+  std::string m_textureName; //!< texture the particles are drawn with
+};
@@ -0,0 +1,72 @@
+/*!****************************************************************************************
+\file       Transform.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's transform, only what the particle system uses. Part of the
+standalone build of the particle system.
+******************************************************************************************/
+#pragma once
+
+#include <cmath>
+#include "../../Math/Vector4.h"
+
+/*!*************************************************************************************
+\par struct: matrix4
+\brief   Linear part of a 2D transform (rotation and scale)
+
+\par baseClass: true
+***************************************************************************************/
+struct matrix4
+{
+  vector4 operator*(const vector4& pVector) const
+  {
+    return vector4(m[0][0] * pVector.x + m[0][1] * pVector.y, m[1][0] * pVector.x + m[1][1] * pVector.y, pVector.z, pVector.w);
+  }
+
+  float m[2][2];
+};
+
+/*!*************************************************************************************
+\par class: transform
+\brief  Position, rotation and scale of an object
+
+\par baseClass: true
+***************************************************************************************/
+class transform
+{
+public:
+  transform(const vector4& pPosition = vector4()) : m_position(pPosition), m_rotation(0.0f), m_scale(1.0f, 1.0f, 1.0f)
+  {
+  }
+
+  const vector4& pos() const { return m_position; }
+  void pos(const vector4& pPosition) { m_position = pPosition; }
+
+  float Rot() const { return m_rotation; }
+  void Rot(float pRotation) { m_rotation = pRotation; }
+
+  const vector4& Scl() const { return m_scale; }
+  void Scl(const vector4& pScale) { m_scale = pScale; }
+  void Scl(float pScale) { m_scale = vector4(pScale, pScale, pScale); }
+
+  matrix4 GetLinearTransformation() const
+  {
+    float cosine = std::cos(m_rotation);
+    float sine = std::sin(m_rotation);
+
+    matrix4 linear;
+    linear.m[0][0] = cosine * m_scale.x;
+    linear.m[0][1] = -sine * m_scale.y;
+    linear.m[1][0] = sine * m_scale.x;
+    linear.m[1][1] = cosine * m_scale.y;
+    return linear;
+  }
+
+private:
+  vector4 m_position; //!< position of the object
+  float m_rotation;   //!< rotation of the object in radians
+  vector4 m_scale;    //!< scale of the object
+};
@@ -0,0 +1,11 @@
+/*!****************************************************************************************
+\file       MessageDrawLine.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's debug line message (the particle system doesn't send it
+anymore). Part of the standalone build of the particle system.
+******************************************************************************************/
+#pragma once
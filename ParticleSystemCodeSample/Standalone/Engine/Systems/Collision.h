@@ -0,0 +1,40 @@
+/*!****************************************************************************************
+\file       Collision.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's collision tests, only the line intersection the exact
+polygon collisions use. Part of the standalone build of the particle system.
+******************************************************************************************/
+#pragma once
+
+#include "../../Math/Vector4.h"
+
+namespace CollisionDetect
+{
+  /*!***********************************************************************************
+  \brief  Intersects segment pA-pB with segment pC-pD
+
+  \return intersection point (pD if the segments don't intersect)
+  *************************************************************************************/
+  inline vector4 LineIntersection(const vector4& pA, const vector4& pB, const vector4& pC, const vector4& pD)
+  {
+    float edgeX = pB.x - pA.x;
+    float edgeY = pB.y - pA.y;
+    float segmentX = pD.x - pC.x;
+    float segmentY = pD.y - pC.y;
+
+    float denominator = edgeX * segmentY - edgeY * segmentX;
+    if (denominator == 0.0f)
+      return pD;
+
+    float t = ((pC.x - pA.x) * segmentY - (pC.y - pA.y) * segmentX) / denominator;
+    float u = ((pC.x - pA.x) * edgeY - (pC.y - pA.y) * edgeX) / denominator;
+    if ((t < 0.0f) || (t > 1.0f) || (u < 0.0f) || (u > 1.0f))
+      return pD;
+
+    return vector4(pA.x + t * edgeX, pA.y + t * edgeY);
+  }
+}
@@ -0,0 +1,49 @@
+/*!****************************************************************************************
+\file       Vector4.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's vector4, only what the particle system uses. Part of the
+standalone build of the particle system (see ../CMakeLists.txt).
+******************************************************************************************/
+#pragma once
+
+#include <cmath>
+
+/*!*************************************************************************************
+\par struct: vector4
+\brief   Four component vector (only x, y and z take part in the dot product)
+
+\par baseClass: true
+***************************************************************************************/
+struct vector4
+{
+  vector4(float pX = 0.0f, float pY = 0.0f, float pZ = 0.0f, float pW = 0.0f) : x(pX), y(pY), z(pZ), w(pW)
+  {
+  }
+
+  vector4 operator+(const vector4& pOther) const { return vector4(x + pOther.x, y + pOther.y, z + pOther.z, w + pOther.w); }
+  vector4 operator-(const vector4& pOther) const { return vector4(x - pOther.x, y - pOther.y, z - pOther.z, w - pOther.w); }
+  vector4 operator*(float pScalar) const { return vector4(x * pScalar, y * pScalar, z * pScalar, w * pScalar); }
+  float operator*(const vector4& pOther) const { return x * pOther.x + y * pOther.y + z * pOther.z; }
+
+  vector4& operator+=(const vector4& pOther) { return *this = *this + pOther; }
+  vector4& operator-=(const vector4& pOther) { return *this = *this - pOther; }
+  vector4& operator*=(float pScalar) { return *this = *this * pScalar; }
+
+  bool operator==(const vector4& pOther) const { return (x == pOther.x) && (y == pOther.y) && (z == pOther.z) && (w == pOther.w); }
+  bool operator!=(const vector4& pOther) const { return !(*this == pOther); }
+
+  void Normalize()
+  {
+    float length = std::sqrt(x * x + y * y + z * z);
+    if (length > 0.0f)
+      *this *= 1.0f / length;
+  }
+
+  void Clear() { x = y = z = w = 0.0f; }
+
+  float x, y, z, w;
+};
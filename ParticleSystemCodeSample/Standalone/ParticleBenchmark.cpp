@@ -0,0 +1,335 @@
+/*!****************************************************************************************
+\file       ParticleBenchmark.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Micro-benchmarks for the particle system, built by the standalone build (see
+../CMakeLists.txt). Every benchmark prints the time spent per particle and the arena
+memory the emitters hold per particle, so changes can be measured off-device.
+
+Run with --quick for fewer frames.
+******************************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "../ParticleEmitter.h"
+#include "../ParticleInstancedEmitter.h"
+#include "../ParticleJobSystem.h"
+#include "../ParticleDistanceField.h"
+#include "Engine/Components/Physics/ColliderPolygon.h"
+#include "Engine/Components/Physics/Physics.h"
+
+namespace
+{
+  const float c_frameTime = 1.0f / 60.0f; //!< every benchmark runs at 60 fps
+  unsigned s_measuredFrames = 300;        //!< frames measured by every benchmark
+
+  /*!***********************************************************************************
+  \brief  Gets the time for the benchmarks
+
+  \return seconds since some fixed point
+  *************************************************************************************/
+  double GetSeconds()
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  /*!***********************************************************************************
+  \brief  Prints a result of a benchmark
+
+  \param pName - name of the benchmark
+  \param pParticles - number of particles it ran with
+  \param pSeconds - time spent on the particles
+  \param pParticleCount - particles processed in that time (added up over all frames)
+  \param pArena - arena the emitters of the benchmark allocated from
+  \param pCapacity - number of particles the emitters can hold
+  *************************************************************************************/
+  void PrintResult(const char* pName, unsigned pParticles, double pSeconds, double pParticleCount, const particleArena& pArena, unsigned pCapacity)
+  {
+    double nsPerParticle = (pParticleCount > 0.0) ? pSeconds * 1e9 / pParticleCount : 0.0;
+    double bytesPerParticle = pCapacity ? static_cast<double>(pArena.GetUsedBytes()) / pCapacity : 0.0;
+
+    std::printf("%-40s %10u %14.2f %16.1f\n", pName, pParticles, nsPerParticle, bytesPerParticle);
+  }
+
+  /*!***********************************************************************************
+  \brief  Gets emitter data for a fountain that keeps pCount particles alive
+
+  \param pName - name of the emitter
+  \param pCount - number of particles the emitter holds
+  \param pLifetime - lifetime of a particle
+  \return emitter data of the fountain
+  *************************************************************************************/
+  emitterData MakeFountain(const char* pName, unsigned pCount, float pLifetime)
+  {
+    emitterData fountain(pName, vector4(0.0f, -9.8f), 0.3f, 0.1f, vector4(1.0f, 0.5f, 0.0f, 1.0f), vector4(0.2f, 0.2f, 1.0f, 0.0f),
+                         1.0f, 6.0f, pCount, 0.0f, pLifetime, static_cast<int>(pCount / pLifetime) + 1);
+    fountain.m_initialAngle = 1.5707963f;
+    fountain.m_randomAngleRange = 0.5f;
+    fountain.m_randomPositionRange = vector4(0.5f, 0.1f, 1.0f);
+    fountain.m_randomSeed = 1;
+    return fountain;
+  }
+
+  /*!***********************************************************************************
+  \brief  Updates an emitter that's full of particles frame after frame
+
+  \param pCount - number of particles
+  \param pIsAnalytic - if the particles are evaluated in closed form
+  *************************************************************************************/
+  void BenchmarkSteadyState(unsigned pCount, bool pIsAnalytic)
+  {
+    particleArena arena;
+    emitterData fountain = MakeFountain("steady", pCount, 2.0f);
+    fountain.m_useAnalyticMotion = pIsAnalytic;
+
+    particleEmitter emitter(fountain, &arena);
+    transform emitterTransform;
+
+      // filling the emitter up before measuring
+    for (unsigned frame = 0; frame < 150; ++frame)
+      emitter.UpdateParticleEmitter(c_frameTime, emitterTransform);
+
+    double particleCount = 0.0;
+    double start = GetSeconds();
+    for (unsigned frame = 0; frame < s_measuredFrames; ++frame)
+    {
+      emitter.UpdateParticleEmitter(c_frameTime, emitterTransform);
+      particleCount += emitter.GetLiveParticleCount();
+    }
+
+    char name[64];
+    std::sprintf(name, "steady state (%s)", pIsAnalytic ? "analytic" : "integrated");
+    PrintResult(name, pCount, GetSeconds() - start, particleCount, arena, pCount);
+  }
+
+  /*!***********************************************************************************
+  \brief  Spawns a whole emitter in one frame and lets all of it die, over and over
+
+  \param pCount - number of particles
+  *************************************************************************************/
+  void BenchmarkBurst(unsigned pCount)
+  {
+    particleArena arena;
+    emitterData burst = MakeFountain("burst", pCount, 0.25f);
+    burst.m_particlesPerSecond = static_cast<int>(pCount / c_frameTime) + 1;
+    burst.m_randomParticleLifetimeRange = 0.05f;
+
+    particleEmitter emitter(burst, &arena);
+    transform emitterTransform;
+
+    double spawnTime = 0.0, deathTime = 0.0;
+    double spawnCount = 0.0, deathCount = 0.0;
+    unsigned burstCount = (s_measuredFrames / 30 > 1) ? s_measuredFrames / 30 : 1;
+
+    for (unsigned i = 0; i < burstCount; ++i)
+    {
+      emitter.RestartEmitter();
+
+      double start = GetSeconds();
+      emitter.UpdateParticleEmitter(c_frameTime, emitterTransform);
+      spawnTime += GetSeconds() - start;
+      spawnCount += emitter.GetLiveParticleCount();
+
+        // only the frames particles die in are measured for the deaths
+      emitter.StopEmitter();
+      while (emitter.GetLiveParticleCount())
+      {
+        unsigned liveCount = emitter.GetLiveParticleCount();
+
+        start = GetSeconds();
+        emitter.UpdateParticleEmitter(c_frameTime, emitterTransform);
+        double frameTime = GetSeconds() - start;
+
+        if (emitter.GetLiveParticleCount() < liveCount)
+        {
+          deathTime += frameTime;
+          deathCount += liveCount - emitter.GetLiveParticleCount();
+        }
+      }
+    }
+
+    PrintResult("burst spawn", pCount, spawnTime, spawnCount, arena, pCount);
+    PrintResult("burst death", pCount, deathTime, deathCount, arena, pCount);
+  }
+
+  /*!***********************************************************************************
+  \brief  Pours particles onto a round polygon collider and times the collision checks
+
+  \param pFaceCount - number of faces of the polygon
+  \param pUseField - if the polygon is baked into a distance field
+  *************************************************************************************/
+  void BenchmarkCollisions(unsigned pFaceCount, bool pUseField)
+  {
+    const unsigned particleCount = 10000;
+
+    particleArena arena;
+    emitterData fountain = MakeFountain("collisions", particleCount, 2.0f);
+    fountain.m_isInteractable = true;
+    fountain.m_initialAngle = -1.5707963f;
+    fountain.m_randomPositionRange = vector4(1.5f, 0.1f);
+    fountain.m_initialVelocity = 2.0f;
+    fountain.m_particleRestistution = 0.7f;
+
+    particleEmitter emitter(fountain, &arena);
+    transform emitterTransform;
+
+    colliderPolygon polygonCollider;
+    physics polygonPhysics;
+    polygonCollider.m_physics = &polygonPhysics;
+
+    for (unsigned i = 0; i < pFaceCount; ++i)
+    {
+      float angle = i * 6.2831853f / pFaceCount;
+      float normalAngle = angle + 3.1415927f / pFaceCount;
+      polygonCollider.m_polygon.m_vertices.push_back(vector4(std::cos(angle) * 1.5f, std::sin(angle) * 1.5f));
+      polygonCollider.m_polygon.m_normals.push_back(vector4(std::cos(normalAngle), std::sin(normalAngle)));
+    }
+
+    transform colliderTransform(vector4(0.0f, -4.0f));
+    particleDistanceField field;
+    if (pUseField)
+      field.Bake(colliderTransform, polygonCollider, 0.05f, 0.5f);
+
+    particleCollider colliders[1] = { { &polygonCollider, &colliderTransform, pUseField ? &field : nullptr } };
+
+    for (unsigned frame = 0; frame < 150; ++frame)
+    {
+      emitter.CheckParticleCollisions(colliders, 1);
+      emitter.UpdateParticleEmitter(c_frameTime, emitterTransform);
+    }
+
+    double collisionTime = 0.0, checkedCount = 0.0;
+    for (unsigned frame = 0; frame < s_measuredFrames; ++frame)
+    {
+      double start = GetSeconds();
+      emitter.CheckParticleCollisions(colliders, 1);
+      collisionTime += GetSeconds() - start;
+      checkedCount += emitter.GetLiveParticleCount();
+
+      emitter.UpdateParticleEmitter(c_frameTime, emitterTransform);
+    }
+
+    char name[64];
+    std::sprintf(name, "collisions, %u faces (%s)", pFaceCount, pUseField ? "distance field" : "exact");
+    PrintResult(name, particleCount, collisionTime, checkedCount, arena, particleCount);
+  }
+
+  /*!***********************************************************************************
+  \brief  Updates lots of small emitters at once
+
+  \param pEmitterCount - number of emitters
+  \param pParticlesPerEmitter - number of particles of every emitter
+  \param pJobSystem - job system the emitters are spread across
+  \param pName - name of the benchmark
+  *************************************************************************************/
+  void BenchmarkManyEmitters(unsigned pEmitterCount, unsigned pParticlesPerEmitter, particleJobSystem& pJobSystem, const char* pName)
+  {
+    particleArena arena;
+    std::vector<std::unique_ptr<particleEmitter> > emitters;
+    std::vector<transform> transforms(pEmitterCount);
+    std::vector<particleEmitterUpdate> updates;
+
+    for (unsigned i = 0; i < pEmitterCount; ++i)
+    {
+      emitterData fountain = MakeFountain("small", pParticlesPerEmitter, 1.0f);
+      fountain.m_randomSeed = i + 1;
+
+      transforms[i].pos(vector4(i * 4.0f, 0.0f));
+      emitters.emplace_back(new particleEmitter(fountain, &arena));
+
+      particleEmitterUpdate update = { emitters.back().get(), &transforms[i] };
+      updates.push_back(update);
+    }
+
+    for (unsigned frame = 0; frame < 90; ++frame)
+      particleEmitter::UpdateParticleEmitters(updates, c_frameTime, pJobSystem);
+
+    double particleCount = 0.0;
+    double start = GetSeconds();
+    for (unsigned frame = 0; frame < s_measuredFrames; ++frame)
+    {
+      particleEmitter::UpdateParticleEmitters(updates, c_frameTime, pJobSystem);
+      for (const std::unique_ptr<particleEmitter>& emitter : emitters)
+        particleCount += emitter->GetLiveParticleCount();
+    }
+    double elapsed = GetSeconds() - start;
+
+    PrintResult(pName, pEmitterCount * pParticlesPerEmitter, elapsed, particleCount, arena, pEmitterCount * pParticlesPerEmitter);
+  }
+
+  /*!***********************************************************************************
+  \brief  Updates lots of placements of one emitter definition as a single instanced
+          emitter (the same setup as BenchmarkManyEmitters)
+
+  \param pInstanceCount - number of instances
+  \param pParticlesPerInstance - number of particles of every instance
+  \param pJobSystem - job system the chunks of particles are spread across
+  \param pName - name of the benchmark
+  *************************************************************************************/
+  void BenchmarkInstancedEmitter(unsigned pInstanceCount, unsigned pParticlesPerInstance, particleJobSystem& pJobSystem, const char* pName)
+  {
+    particleArena arena;
+    emitterDefinition fountain = std::make_shared<const emitterData>(MakeFountain("small", pParticlesPerInstance, 1.0f));
+
+    particleInstancedEmitter emitter(fountain, &arena);
+    emitter.SetJobSystem(&pJobSystem);
+    for (unsigned i = 0; i < pInstanceCount; ++i)
+      emitter.AddInstance(transform(vector4(i * 4.0f, 0.0f)));
+
+    for (unsigned frame = 0; frame < 90; ++frame)
+      emitter.UpdateParticleEmitter(c_frameTime);
+
+    double particleCount = 0.0;
+    double start = GetSeconds();
+    for (unsigned frame = 0; frame < s_measuredFrames; ++frame)
+    {
+      emitter.UpdateParticleEmitter(c_frameTime);
+      particleCount += emitter.GetLiveParticleCount();
+    }
+    double elapsed = GetSeconds() - start;
+
+    PrintResult(pName, pInstanceCount * pParticlesPerInstance, elapsed, particleCount, arena, pInstanceCount * pParticlesPerInstance);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!std::strcmp(argv[i], "--quick"))
+      s_measuredFrames = 30;
+  }
+
+  std::printf("%-40s %10s %14s %16s\n", "benchmark", "particles", "ns/particle", "bytes/particle");
+
+  for (unsigned count : { 1000u, 10000u, 100000u })
+  {
+    BenchmarkSteadyState(count, true);
+    BenchmarkSteadyState(count, false);
+  }
+
+  BenchmarkBurst(100000);
+
+  for (unsigned faceCount : { 16u, 64u, 256u })
+  {
+    BenchmarkCollisions(faceCount, false);
+    BenchmarkCollisions(faceCount, true);
+  }
+
+    // the thread waiting on the jobs works as well, so no workers runs everything on it
+  particleJobSystem serialJobs(0);
+  particleJobSystem parallelJobs;
+  BenchmarkManyEmitters(1000, 100, serialJobs, "many small emitters (1 thread)");
+  BenchmarkManyEmitters(1000, 100, parallelJobs, "many small emitters (job system)");
+  BenchmarkInstancedEmitter(1000, 100, serialJobs, "instanced emitter (1 thread)");
+  BenchmarkInstancedEmitter(1000, 100, parallelJobs, "instanced emitter (job system)");
+
+  return 0;
+}
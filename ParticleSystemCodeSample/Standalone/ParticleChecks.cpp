@@ -0,0 +1,851 @@
+/*!****************************************************************************************
+\file       ParticleChecks.cpp
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Checks for the particle system, built by the standalone build (see ../CMakeLists.txt) and
+run by ctest. Every check prints what failed, and the exit code is the number of failed
+checks.
+******************************************************************************************/
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include "../ParticleEmitter.h"
+#include "../ParticleGPURing.h"
+#include "../ParticleInstancedEmitter.h"
+#include "../ParticleKernels.h"
+#include "../ParticleRandom.h"
+#include "../ParticleStorage.h"
+
+namespace
+{
+  unsigned s_failureCount = 0; //!< number of failed checks so far
+
+  const unsigned c_kernelParticleCount = 1003; //!< particles the kernels are checked with (leaves a tail for every instruction set)
+  const unsigned c_kernelBegin = 3;            //!< first particle the kernels run from (so the SIMD loads aren't aligned)
+
+    // a kernel run on the particles, exact results besides the particles (counts, indices,
+    // bits) go into the vector
+  typedef std::function<void(particleStorage&, std::vector<std::uint32_t>&)> kernelRun;
+
+  /*!***********************************************************************************
+  \brief  Counts a failed check and prints it
+
+  \param pIsPassing - if the check passed
+  \param pCheck - name of the check
+  \param pWhat - what was checked
+  *************************************************************************************/
+  void Check(bool pIsPassing, const char* pCheck, const char* pWhat)
+  {
+    if (pIsPassing)
+      return;
+
+    std::printf("FAILED %s: %s\n", pCheck, pWhat);
+    ++s_failureCount;
+  }
+
+  /*!***********************************************************************************
+  \brief  Gets the name of an instruction set
+
+  \param pInstructionSet - instruction set
+  \return name to print
+  *************************************************************************************/
+  const char* GetInstructionSetName(ParticleKernels::instructionSet pInstructionSet)
+  {
+    switch (pInstructionSet)
+    {
+    case ParticleKernels::is_sse2:
+      return "SSE2";
+    case ParticleKernels::is_avx2:
+      return "AVX2";
+    default:
+      return "scalar";
+    }
+  }
+
+  /*!***********************************************************************************
+  \brief  Fills a storage with the same random particles every time. Every third one
+          has no angular velocity (so it faces its direction of movement) and every
+          fifth one is inactive.
+
+  \return storage of c_kernelParticleCount particles
+  *************************************************************************************/
+  particleStorage MakeRandomParticles()
+  {
+    const unsigned count = c_kernelParticleCount;
+    particleStorage particles(count, nullptr);
+    particleRandom random(7);
+
+    random.FillRange(particles.m_positionX, count, -10.0f, 10.0f);
+    random.FillRange(particles.m_positionY, count, -10.0f, 10.0f);
+    random.FillRange(particles.m_positionZ, count, -1.0f, 1.0f);
+    random.FillRange(particles.m_velocityX, count, -5.0f, 5.0f);
+    random.FillRange(particles.m_velocityY, count, -5.0f, 5.0f);
+    random.FillRange(particles.m_forceX, count, -1.0f, 1.0f);
+    random.FillRange(particles.m_forceY, count, -1.0f, 1.0f);
+    random.FillRange(particles.m_rotation, count, -3.0f, 3.0f);
+    random.FillRange(particles.m_angularVelocity, count, -2.0f, 2.0f);
+    random.FillRange(particles.m_currentLifetime, count, 0.0f, 2.0f);
+    random.FillRange(particles.m_totalLifetime, count, 0.5f, 2.0f);
+    random.FillRange(particles.m_randomScale, count * 2, 0.1f, 2.0f);
+    random.FillRange(particles.m_scale, count, 0.1f, 2.0f);
+    random.FillRange(particles.m_colorR, count, 0.0f, 1.0f);
+    random.FillRange(particles.m_colorG, count, 0.0f, 1.0f);
+    random.FillRange(particles.m_colorB, count, 0.0f, 1.0f);
+    random.FillRange(particles.m_colorA, count, 0.0f, 1.0f);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+      particles.m_oldPositionX[i] = particles.m_positionX[i];
+      particles.m_oldPositionY[i] = particles.m_positionY[i];
+      if (!(i % 3))
+        particles.m_angularVelocity[i] = 0.0f;
+      particles.m_isActive[i] = (i % 5) != 0;
+    }
+
+    return particles;
+  }
+
+  /*!***********************************************************************************
+  \brief  Checks that two storages hold the same particles within float tolerance.
+          Rotations are compared as angles, since atan2 gives -pi or pi for the same
+          direction.
+
+  \param pReference - particles the scalar kernel gave
+  \param pParticles - particles another instruction set gave
+  \param pWhat - kernel and instruction set, for the failure message
+  *************************************************************************************/
+  void CheckSameParticles(const particleStorage& pReference, const particleStorage& pParticles, const std::string& pWhat)
+  {
+    float* particleStorage::* const c_columns[] =
+    {
+      &particleStorage::m_positionX, &particleStorage::m_positionY, &particleStorage::m_positionZ,
+      &particleStorage::m_oldPositionX, &particleStorage::m_oldPositionY,
+      &particleStorage::m_velocityX, &particleStorage::m_velocityY, &particleStorage::m_forceX, &particleStorage::m_forceY,
+      &particleStorage::m_angularVelocity, &particleStorage::m_currentLifetime, &particleStorage::m_totalLifetime,
+      &particleStorage::m_scale, &particleStorage::m_colorR, &particleStorage::m_colorG, &particleStorage::m_colorB, &particleStorage::m_colorA
+    };
+
+    bool isSame = true;
+    for (unsigned i = 0; i < c_kernelParticleCount; ++i)
+    {
+      for (float* particleStorage::* column : c_columns)
+      {
+        float reference = (pReference.*column)[i];
+        isSame = isSame && (std::fabs((pParticles.*column)[i] - reference) <= 1e-5f * std::fmax(1.0f, std::fabs(reference)));
+      }
+
+      float rotationError = std::remainder(pParticles.m_rotation[i] - pReference.m_rotation[i], 6.2831853f);
+      isSame = isSame && (std::fabs(rotationError) <= 1e-4f * std::fmax(1.0f, std::fabs(pReference.m_rotation[i])));
+      isSame = isSame && (pParticles.m_randomScale[i * 2] == pReference.m_randomScale[i * 2]);
+      isSame = isSame && (pParticles.m_randomScale[i * 2 + 1] == pReference.m_randomScale[i * 2 + 1]);
+      isSame = isSame && (pParticles.m_isActive[i] == pReference.m_isActive[i]);
+    }
+
+    Check(isSame, pWhat.c_str(), "particles match the scalar kernel within float tolerance");
+  }
+
+  /*!***********************************************************************************
+  \brief  Runs a kernel on the same particles with every instruction set the cpu
+          supports, and checks that they all give what the scalar version gives
+
+  \param pName - name of the kernel
+  \param pRun - runs the kernel
+  *************************************************************************************/
+  void CheckKernel(const std::string& pName, const kernelRun& pRun)
+  {
+    ParticleKernels::instructionSet previousSet = ParticleKernels::GetInstructionSet();
+
+    particleStorage reference = MakeRandomParticles();
+    std::vector<std::uint32_t> referenceResults;
+    ParticleKernels::SetInstructionSet(ParticleKernels::is_scalar);
+    pRun(reference, referenceResults);
+
+    for (ParticleKernels::instructionSet instructionSet : { ParticleKernels::is_sse2, ParticleKernels::is_avx2 })
+    {
+        // sets the cpu doesn't support can't be checked
+      if (ParticleKernels::SetInstructionSet(instructionSet) != instructionSet)
+        continue;
+
+      particleStorage particles = MakeRandomParticles();
+      std::vector<std::uint32_t> results;
+      pRun(particles, results);
+
+      std::string what = pName + " (" + GetInstructionSetName(instructionSet) + ")";
+      CheckSameParticles(reference, particles, what);
+      Check(results == referenceResults, what.c_str(), "results match the scalar kernel exactly");
+    }
+
+    ParticleKernels::SetInstructionSet(previousSet);
+  }
+
+  /*!***********************************************************************************
+  \brief  Every kernel gives the same results with the scalar, SSE2 and AVX2 versions
+  *************************************************************************************/
+  void CheckKernelsAgree()
+  {
+    const unsigned begin = c_kernelBegin, end = c_kernelParticleCount;
+    const vector4 force(0.5f, -9.8f);
+    const vector4 initialColor(1.0f, 0.5f, 0.0f, 1.0f), finalColor(0.2f, 0.2f, 1.0f, 0.0f);
+
+    CheckKernel("UpdateLifetimes", [=](particleStorage& pParticles, std::vector<std::uint32_t>&)
+    {
+      ParticleKernels::UpdateLifetimes(pParticles, begin, end, 1.0f / 60.0f);
+    });
+
+    for (unsigned features = 0; features <= ParticleKernels::uf_all; ++features)
+    {
+      CheckKernel("update kernel " + std::to_string(features), [=](particleStorage& pParticles, std::vector<std::uint32_t>&)
+      {
+        ParticleKernels::updateParameters parameters = { force, initialColor, finalColor, 1.0f / 60.0f };
+        ParticleKernels::GetUpdateKernel(features)(pParticles, begin, end, parameters);
+      });
+    }
+
+    CheckKernel("EvaluateParticles", [=](particleStorage& pParticles, std::vector<std::uint32_t>&)
+    {
+        // evaluated in place, so the results are compared with the rest of the particles
+      ParticleKernels::evaluateParameters parameters = { force, initialColor, finalColor, 0.25f };
+      ParticleKernels::evaluatedColumns columns = { pParticles.m_positionX + begin, pParticles.m_positionY + begin, pParticles.m_rotation + begin,
+                                                    pParticles.m_scale + begin, pParticles.m_colorR + begin, pParticles.m_colorG + begin,
+                                                    pParticles.m_colorB + begin, pParticles.m_colorA + begin };
+      ParticleKernels::EvaluateParticles(pParticles, begin, end, parameters, columns);
+    });
+
+    CheckKernel("MarkDeadParticles", [=](particleStorage& pParticles, std::vector<std::uint32_t>& pResults)
+    {
+      pResults.push_back(ParticleKernels::MarkDeadParticles(pParticles, begin, end));
+    });
+
+    CheckKernel("FindParticlesInPolygon", [=](particleStorage& pParticles, std::vector<std::uint32_t>& pResults)
+    {
+        // a diamond around the origin
+      const float planes[] = { 0.7071068f, 0.7071068f, 4.0f, -0.7071068f, 0.7071068f, 4.0f, -0.7071068f, -0.7071068f, 4.0f, 0.7071068f, -0.7071068f, 4.0f };
+      ParticleKernels::polygonPlanes polygon = { planes, 4, -5.7f, -5.7f, 5.7f, 5.7f };
+
+      std::vector<unsigned> inside(end - begin);
+      pResults.assign(inside.begin(), inside.begin() + ParticleKernels::FindParticlesInPolygon(pParticles, begin, end, polygon, inside.data()));
+    });
+
+    CheckKernel("FindParticlesInCircle", [=](particleStorage& pParticles, std::vector<std::uint32_t>& pResults)
+    {
+      ParticleKernels::circleShape circle = { 2.0f, -1.0f, 4.5f };
+
+      std::vector<unsigned> inside(end - begin);
+      pResults.assign(inside.begin(), inside.begin() + ParticleKernels::FindParticlesInCircle(pParticles, begin, end, circle, inside.data()));
+    });
+
+    CheckKernel("ComputeBounds", [=](particleStorage& pParticles, std::vector<std::uint32_t>& pResults)
+    {
+      float bounds[4];
+      ParticleKernels::ComputeBounds(pParticles, begin, end, bounds);
+
+      pResults.resize(4);
+      std::memcpy(pResults.data(), bounds, sizeof(bounds));
+    });
+
+    CheckKernel("PackParticles", [=](particleStorage& pParticles, std::vector<std::uint32_t>& pResults)
+    {
+        // rotations of particles that spun for a while, so they're wrapped before packing
+      for (unsigned i = begin; i < end; ++i)
+        pParticles.m_rotation[i] += 6.2831853f * static_cast<float>(i % 100) * ((i & 1) ? 1.0f : -1.0f);
+
+      std::vector<ParticleKernels::packedParticle> packed(end - begin);
+      ParticleKernels::PackParticles(pParticles, begin, end, vector4(1.0f, -2.0f, 0.0f), packed.data());
+
+      pResults.resize(packed.size() * sizeof(ParticleKernels::packedParticle) / sizeof(std::uint32_t));
+      std::memcpy(pResults.data(), packed.data(), packed.size() * sizeof(ParticleKernels::packedParticle));
+    });
+
+    CheckKernel("CompactParticles", [=](particleStorage& pParticles, std::vector<std::uint32_t>& pResults)
+    {
+      pResults.push_back(ParticleKernels::CompactParticles(pParticles, end));
+      for (unsigned i = 0; i < pParticles.m_moveCount; ++i)
+      {
+        pResults.push_back(pParticles.m_moves[i].m_from);
+        pResults.push_back(pParticles.m_moves[i].m_to);
+      }
+    });
+  }
+
+  /*!***********************************************************************************
+  \brief  Gets emitter data for a fountain that keeps pCount particles alive
+
+  \param pCount - number of particles the emitter holds
+  \return emitter data of the fountain
+  *************************************************************************************/
+  emitterData MakeFountain(unsigned pCount)
+  {
+    emitterData fountain("checks", vector4(0.0f, -9.8f), 0.3f, 0.1f, vector4(1.0f, 0.5f, 0.0f, 1.0f), vector4(0.2f, 0.2f, 1.0f, 0.0f),
+                         1.0f, 6.0f, pCount, 0.0f, 1.0f, static_cast<int>(pCount * 2));
+    fountain.m_initialAngle = 1.5707963f;
+    fountain.m_randomAngleRange = 0.5f;
+    fountain.m_randomPositionRange = vector4(0.5f, 0.1f, 1.0f);
+    fountain.m_randomParticleLifetimeRange = 0.25f;
+    fountain.m_randomSeed = 1;
+
+      // a wave on time of 0 would pause the emitter every other frame
+    fountain.m_waveOnTime = 1000.0f;
+    return fountain;
+  }
+
+  /*!***********************************************************************************
+  \brief  An emitter spawning faster than its particles die fills up to its pool and
+          hands all of it to the renderer
+  *************************************************************************************/
+  void CheckEmitterFills()
+  {
+    particleEmitter emitter(MakeFountain(500));
+    transform emitterTransform;
+    emitter.RestartEmitter();
+
+    for (unsigned frame = 0; frame < 60; ++frame)
+      emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+
+    unsigned gpuCount = 0;
+    emitter.GetLiveGPUData(gpuCount);
+
+    Check(emitter.GetLiveParticleCount() == 500, "emitter fills", "live count reaches the pool size");
+    Check(gpuCount == 500, "emitter fills", "every live particle is handed to the renderer");
+  }
+
+  /*!***********************************************************************************
+  \brief  Only emitters that ask for it evaluate their particles in closed form, every
+          other one keeps the current particles in its storage
+  *************************************************************************************/
+  void CheckAnalyticIsOptIn()
+  {
+    emitterData fountain = MakeFountain(200);
+    transform emitterTransform;
+
+    particleEmitter emitter(fountain);
+    emitter.RestartEmitter();
+    for (unsigned frame = 0; frame < 30; ++frame)
+      emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+
+    unsigned gpuCount = 0;
+    const shaderHandler::gPUData* gpuData = emitter.GetLiveGPUData(gpuCount);
+    particleStorage& particles = emitter.GetParticles();
+
+    bool isCurrent = gpuCount > 0;
+    for (unsigned i = 0; i < gpuCount; ++i)
+      isCurrent = isCurrent && (gpuData[i].m_particleTransform.pos().x == particles.m_positionX[i]) && (gpuData[i].m_particleTransform.pos().y == particles.m_positionY[i]);
+
+    Check(!emitter.IsAnalytic(), "analytic opt-in", "emitters are integrated unless they ask for closed form");
+    Check(isCurrent, "analytic opt-in", "the storage holds the positions that are rendered");
+
+    fountain.m_useAnalyticMotion = true;
+    particleEmitter analyticEmitter(fountain);
+    Check(analyticEmitter.IsAnalytic(), "analytic opt-in", "emitters that ask for closed form get it");
+
+    fountain.m_isInteractable = true;
+    particleEmitter interactableEmitter(fountain);
+    Check(!interactableEmitter.IsAnalytic(), "analytic opt-in", "colliding particles are always integrated");
+  }
+
+  /*!***********************************************************************************
+  \brief  Finds the oldest particle of a ring buffer that isn't full
+
+  \param pParticles - storage of the ring buffer
+  \return slot of the oldest particle (0 if there are none)
+  *************************************************************************************/
+  unsigned FindRingStart(const particleStorage& pParticles)
+  {
+    unsigned capacity = pParticles.size();
+    for (unsigned i = 0; i < capacity; ++i)
+    {
+      if (pParticles.m_isActive[i] && !pParticles.m_isActive[(i + capacity - 1) % capacity])
+        return i;
+    }
+
+    return 0;
+  }
+
+  /*!***********************************************************************************
+  \brief  An emitter whose particles all live as long keeps them in a ring buffer. Its
+          gpu data holds the particles oldest first after the ring wrapped around the end
+          of the storage, spawns straddling the end land on both sides, and a gpu ring
+          smaller than the live count gets the oldest particles. The emitter turns back
+          into plain storage once the lifetimes get a random range.
+  *************************************************************************************/
+  void CheckRingBuffer()
+  {
+    emitterData fountain = MakeFountain(200);
+    fountain.m_randomParticleLifetimeRange = 0.0f;
+
+      // 3 particles a frame, so the spawns straddle the end of the storage
+    fountain.m_particlesPerSecond = 180;
+
+    particleEmitter emitter(fountain);
+    transform emitterTransform;
+    emitter.RestartEmitter();
+    Check(emitter.IsRingBuffer(), "ring buffer", "particles that all live as long are kept in a ring buffer");
+
+      // a twin of the emitter writing into a gpu ring with room for fewer particles
+    const unsigned ringCapacity = 150;
+    std::vector<shaderHandler::gPUData> ringMemory(particleGPURing::c_frameCount * ringCapacity);
+    particleGPURing ring(ringMemory.data(), ringCapacity);
+    particleEmitter ringEmitter(fountain);
+    ringEmitter.SetGPURing(&ring);
+    ringEmitter.RestartEmitter();
+
+    particleStorage& particles = emitter.GetParticles();
+    unsigned capacity = particles.size();
+    bool isInOrder = true, isAlive = true, isClipped = true;
+    bool hasWrapped = false, hasSpawnedAcrossEnd = false, hasClippedAcrossEnd = false;
+
+    for (unsigned frame = 0; frame < 240; ++frame)
+    {
+      emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+      ringEmitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+
+      unsigned liveCount = emitter.GetLiveParticleCount();
+      unsigned start = FindRingStart(particles);
+      hasWrapped = hasWrapped || (start + liveCount > capacity);
+      hasClippedAcrossEnd = hasClippedAcrossEnd || ((start + liveCount > capacity) && (capacity - start < ringCapacity) && (liveCount > ringCapacity));
+      hasSpawnedAcrossEnd = hasSpawnedAcrossEnd || (particles.m_isActive[capacity - 1] && particles.m_isActive[0] &&
+                                                    particles.m_currentLifetime[capacity - 1] == 0.0f && particles.m_currentLifetime[0] == 0.0f);
+
+      unsigned gpuCount = 0, activeCount = 0;
+      const shaderHandler::gPUData* gpuData = emitter.GetLiveGPUData(gpuCount);
+      isInOrder = isInOrder && (gpuCount == liveCount);
+
+      for (unsigned i = 0; i < capacity; ++i)
+        activeCount += particles.m_isActive[i];
+      isAlive = isAlive && (activeCount == liveCount);
+
+      for (unsigned k = 0; isInOrder && k < liveCount; ++k)
+      {
+        unsigned i = (start + k) % capacity;
+        unsigned previous = (i + capacity - 1) % capacity;
+
+        isInOrder = particles.m_isActive[i] && (gpuData[k].m_particleTransform.pos().x == particles.m_positionX[i]) &&
+                    (gpuData[k].m_particleTransform.pos().y == particles.m_positionY[i]) &&
+                    (!k || (particles.m_currentLifetime[i] <= particles.m_currentLifetime[previous]));
+        isAlive = isAlive && (particles.m_currentLifetime[i] <= particles.m_totalLifetime[i]);
+      }
+
+      const shaderHandler::gPUData* uploadData = nullptr;
+      unsigned uploadCount = 0;
+      unsigned expectedCount = (liveCount < ringCapacity) ? liveCount : ringCapacity;
+      isClipped = isClipped && ring.BeginUpload(uploadData, uploadCount) && (uploadCount == expectedCount);
+
+      for (unsigned k = 0; isClipped && k < uploadCount; ++k)
+      {
+        isClipped = (uploadData[k].m_particleTransform.pos().x == gpuData[k].m_particleTransform.pos().x) &&
+                    (uploadData[k].m_particleTransform.pos().y == gpuData[k].m_particleTransform.pos().y);
+      }
+    }
+
+    Check(hasWrapped, "ring buffer", "the live particles wrap around the end of the storage");
+    Check(hasSpawnedAcrossEnd, "ring buffer", "a frame's spawns straddle the end of the storage");
+    Check(hasClippedAcrossEnd, "ring buffer", "the gpu ring is clipped inside the wrapped part");
+    Check(isInOrder, "ring buffer", "the gpu data holds the live particles oldest first");
+    Check(isAlive, "ring buffer", "the oldest particles die once they lived their whole life");
+    Check(isClipped, "ring buffer", "a gpu ring smaller than the live count gets the oldest particles");
+
+      // turning into plain storage while the ring is wrapped
+    for (unsigned frame = 0; frame < 200 && FindRingStart(particles) + emitter.GetLiveParticleCount() <= capacity; ++frame)
+      emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+
+    emitter.GetEmitterData().m_randomParticleLifetimeRange = 0.25f;
+    emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+
+    unsigned liveCount = emitter.GetLiveParticleCount();
+    unsigned gpuCount = 0;
+    const shaderHandler::gPUData* gpuData = emitter.GetLiveGPUData(gpuCount);
+
+    bool isPlain = !emitter.IsRingBuffer() && (gpuCount == liveCount) && (liveCount > 0);
+    for (unsigned i = 0; isPlain && i < capacity; ++i)
+    {
+      isPlain = (particles.m_isActive[i] != 0) == (i < liveCount);
+      if (isPlain && (i < liveCount))
+        isPlain = (gpuData[i].m_particleTransform.pos().x == particles.m_positionX[i]) && (gpuData[i].m_particleTransform.pos().y == particles.m_positionY[i]);
+    }
+
+    Check(isPlain, "ring buffer", "a random lifetime range turns the ring back into plain storage with the particles at the front");
+  }
+
+  /*!***********************************************************************************
+  \brief  A depth sorted emitter draws every live particle once, back to front, while
+          particles die and spawn. Checked for both sorts, with the particles compacted
+          and kept in a ring buffer.
+  *************************************************************************************/
+  void CheckDepthSort()
+  {
+    const particleDepthSortMode modes[] = { dsm_full, dsm_incremental };
+    const float lifetimeRanges[] = { 0.25f, 0.0f };
+
+    for (particleDepthSortMode mode : modes)
+    {
+      for (float lifetimeRange : lifetimeRanges)
+      {
+        emitterData fountain = MakeFountain(200);
+        fountain.m_randomParticleLifetimeRange = lifetimeRange;
+
+          // the depth is quantized to 16 bits over the range of z, particles closer
+          // than that can be drawn in either order
+        float tolerance = 2.0f * fountain.m_randomPositionRange.z / 65535.0f;
+
+        particleEmitter emitter(fountain);
+        transform emitterTransform;
+        emitter.SetDepthSort(mode);
+        emitter.RestartEmitter();
+
+        bool isPermutation = true, isSorted = true;
+        for (unsigned frame = 0; frame < 150; ++frame)
+        {
+          emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+
+          unsigned liveCount = emitter.GetLiveParticleCount();
+          unsigned gpuCount = 0, orderCount = 0;
+          const shaderHandler::gPUData* gpuData = emitter.GetLiveGPUData(gpuCount);
+          const unsigned* order = emitter.GetDrawOrder(orderCount);
+
+          std::vector<bool> isDrawn(liveCount, false);
+          isPermutation = isPermutation && (orderCount == liveCount) && (gpuCount == liveCount);
+
+          for (unsigned k = 0; isPermutation && k < orderCount; ++k)
+          {
+            isPermutation = (order[k] < liveCount) && !isDrawn[order[k]];
+            if (isPermutation)
+              isDrawn[order[k]] = true;
+          }
+
+          for (unsigned k = 1; isPermutation && isSorted && k < orderCount; ++k)
+            isSorted = gpuData[order[k]].m_particleTransform.pos().z >= gpuData[order[k - 1]].m_particleTransform.pos().z - tolerance;
+        }
+
+        const char* name = (mode == dsm_full) ? "full depth sort" : "incremental depth sort";
+        const char* storage = lifetimeRange ? "compacted" : "ring buffer";
+        std::string permutationWhat = std::string("every live particle is drawn once (") + storage + ")";
+        std::string sortedWhat = std::string("the particles are drawn back to front (") + storage + ")";
+        Check(isPermutation, name, permutationWhat.c_str());
+        Check(isSorted, name, sortedWhat.c_str());
+      }
+    }
+  }
+
+  /*!***********************************************************************************
+  \brief  Adds up the squared speeds of an emitter's live particles
+
+  \param pEmitter - emitter holding the particles
+  \return sum of the squared speeds
+  *************************************************************************************/
+  float GetSquaredSpeeds(particleEmitter& pEmitter)
+  {
+    particleStorage& particles = pEmitter.GetParticles();
+
+    float squaredSpeeds = 0.0f;
+    for (unsigned i = 0; i < pEmitter.GetLiveParticleCount(); ++i)
+      squaredSpeeds += particles.m_velocityX[i] * particles.m_velocityX[i] + particles.m_velocityY[i] * particles.m_velocityY[i];
+
+    return squaredSpeeds;
+  }
+
+  /*!***********************************************************************************
+  \brief  Overlapping particles of a self interacting emitter are moved apart without
+          speeding up, even when they spawned on top of each other, and particles moving
+          towards each other don't bounce off faster than they came in
+  *************************************************************************************/
+  void CheckSelfInteraction()
+  {
+    emitterData pair = MakeFountain(2);
+    pair.m_constantAcceleration = vector4();
+    pair.m_initialVelocity = 0.0f;
+    pair.m_randomAngleRange = 0.0f;
+    pair.m_randomPositionRange = vector4();
+    pair.m_initialScale = pair.m_finalScale = 0.2f;
+    pair.m_randomScaleFactor = 0.0f;
+    pair.m_particlesPerSecond = 1000;
+    pair.m_particleRestistution = 0.0f;
+    pair.m_interactsWithSelf = true;
+
+    particleEmitter emitter(pair);
+    transform emitterTransform;
+    emitter.RestartEmitter();
+
+      // both particles spawn on top of each other in the first frame
+    emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+    particleStorage& particles = emitter.GetParticles();
+    Check(emitter.GetLiveParticleCount() == 2 && particles.m_positionX[0] == particles.m_positionX[1], "self interaction", "the pair spawns on top of each other");
+
+    emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+    Check(std::fabs(particles.m_positionX[0] - particles.m_positionX[1]) >= 0.2f - 1e-5f, "self interaction", "particles on top of each other are moved apart");
+    Check(GetSquaredSpeeds(emitter) == 0.0f, "self interaction", "particles on top of each other don't speed up");
+
+      // a resting pair overlapping by half
+    particles.m_positionX[0] = -0.05f;
+    particles.m_positionX[1] = 0.05f;
+    particles.m_positionY[0] = particles.m_positionY[1] = 0.0f;
+    for (unsigned frame = 0; frame < 10; ++frame)
+      emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+
+    Check(std::fabs(particles.m_positionX[0] - particles.m_positionX[1]) >= 0.2f - 1e-5f, "self interaction", "an overlapping pair at rest is moved apart");
+    Check(GetSquaredSpeeds(emitter) == 0.0f, "self interaction", "an overlapping pair at rest doesn't speed up");
+
+      // the same pair running into each other
+    particles.m_positionX[0] = -0.05f;
+    particles.m_positionX[1] = 0.05f;
+    particles.m_velocityX[0] = 1.0f;
+    particles.m_velocityX[1] = -1.0f;
+    float squaredSpeeds = GetSquaredSpeeds(emitter);
+    emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+
+    Check(GetSquaredSpeeds(emitter) <= squaredSpeeds, "self interaction", "colliding particles don't gain kinetic energy");
+
+      // a dense stream without gravity, where particles bounce off several others at once
+    emitterData stream = pair;
+    stream.m_numberofParticles = 200;
+    stream.m_particlesPerSecond = 120;
+    stream.m_initialVelocity = 6.0f;
+    stream.m_randomAngleRange = 0.3f;
+    stream.m_totalParticleLifetime = 3.0f;
+
+    particleEmitter streamEmitter(stream);
+    streamEmitter.RestartEmitter();
+
+    bool isSlowEnough = true;
+    for (unsigned frame = 0; frame < 300; ++frame)
+    {
+      streamEmitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+      isSlowEnough = isSlowEnough && (GetSquaredSpeeds(streamEmitter) <= 36.01f * streamEmitter.GetLiveParticleCount());
+    }
+
+    Check(isSlowEnough, "self interaction", "a stream of particles never moves faster than it spawned");
+  }
+
+  /*!***********************************************************************************
+  \brief  Turns a half float back into a float (normal and denormal halves only)
+
+  \param pHalf - bits of the half float
+  \return value of the half float
+  *************************************************************************************/
+  float HalfToFloat(std::uint16_t pHalf)
+  {
+    int exponent = (pHalf >> 10) & 0x1F;
+    float mantissa = static_cast<float>(pHalf & 0x3FF) / 1024.0f;
+    float magnitude = exponent ? std::ldexp(1.0f + mantissa, exponent - 15) : std::ldexp(mantissa, -14);
+    return (pHalf & 0x8000) ? -magnitude : magnitude;
+  }
+
+  /*!***********************************************************************************
+  \brief  Packed rotations are wrapped to [-pi, pi) no matter how far the particles spun,
+          and a packing emitter hands its gpu data over as packed data only
+  *************************************************************************************/
+  void CheckPackedGPUData()
+  {
+    const unsigned count = 64;
+    particleStorage particles(count, nullptr);
+    std::vector<float> angles(count);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+      angles[i] = -3.0f + 6.0f * static_cast<float>(i) / count;
+      particles.m_rotation[i] = angles[i] + 6.2831853f * static_cast<float>(i * 7);
+    }
+
+    std::vector<ParticleKernels::packedParticle> packed(count);
+    ParticleKernels::PackParticles(particles, 0, count, vector4(), packed.data());
+
+    bool isWrapped = true;
+    for (unsigned i = 0; i < count; ++i)
+      isWrapped = isWrapped && (std::fabs(HalfToFloat(packed[i].m_rotation) - angles[i]) < 2e-3f);
+
+    Check(isWrapped, "packed gpu data", "spun rotations are packed as the same angle in [-pi, pi)");
+
+    particleEmitter emitter(MakeFountain(200));
+    transform emitterTransform;
+    emitter.SetGPUDataFormat(gdf_packed);
+    emitter.RestartEmitter();
+
+    for (unsigned frame = 0; frame < 30; ++frame)
+      emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+
+    unsigned gpuCount = 0, packedCount = 0;
+    vector4 origin;
+    emitter.GetLiveGPUData(gpuCount);
+    emitter.GetPackedGPUData(packedCount, origin);
+
+    Check(gpuCount == 0, "packed gpu data", "no full gpu data is handed out while packing");
+    Check(packedCount == emitter.GetLiveParticleCount() && packedCount > 0, "packed gpu data", "every live particle is packed");
+  }
+
+  /*!***********************************************************************************
+  \brief  Writes a frame of the gpu ring, marking every particle with the frame's number
+
+  \param pRing - ring to write to
+  \param pFrame - number marking the frame
+  \param pCount - number of particles written
+  \return frame written
+  *************************************************************************************/
+  const shaderHandler::gPUData* WriteRingFrame(particleGPURing& pRing, float pFrame, unsigned pCount)
+  {
+    shaderHandler::gPUData* frame = pRing.BeginWrite();
+    for (unsigned i = 0; i < pRing.GetCapacity(); ++i)
+      frame[i].m_particleTransform.Rot(pFrame);
+
+    pRing.EndWrite(pCount);
+    return frame;
+  }
+
+  /*!***********************************************************************************
+  \brief  The gpu ring hands the newest written frame to the reader, never the one being
+          written, only once, and with its count clamped to the capacity
+  *************************************************************************************/
+  void CheckGPURing()
+  {
+      // a heap buffer stands in for the mapped staging buffer
+    const unsigned capacity = 4;
+    std::vector<shaderHandler::gPUData> memory(particleGPURing::c_frameCount * capacity);
+    particleGPURing ring(memory.data(), capacity);
+
+    const shaderHandler::gPUData* uploadData = nullptr;
+    unsigned uploadCount = 0;
+    Check(!ring.BeginUpload(uploadData, uploadCount), "gpu ring", "nothing is uploaded before the first write");
+
+    const shaderHandler::gPUData* frame = WriteRingFrame(ring, 1.0f, 2);
+    Check(ring.BeginUpload(uploadData, uploadCount), "gpu ring", "a written frame is uploaded");
+    Check(uploadData == frame && uploadCount == 2 && uploadData[0].m_particleTransform.Rot() == 1.0f, "gpu ring", "the upload gets the written frame and count");
+    Check(ring.BeginWrite() != uploadData, "gpu ring", "the writer never gets the frame being uploaded");
+    Check(!ring.BeginUpload(uploadData, uploadCount), "gpu ring", "a frame is only uploaded once");
+
+    WriteRingFrame(ring, 2.0f, capacity * 3);
+    Check(ring.BeginUpload(uploadData, uploadCount), "gpu ring", "the next written frame is uploaded");
+    Check(uploadCount == capacity && uploadData[0].m_particleTransform.Rot() == 2.0f, "gpu ring", "the count is clamped to the capacity");
+
+      // the writer runs ahead of the reader, the frame it skipped is never uploaded
+    const shaderHandler::gPUData* skippedFrame = WriteRingFrame(ring, 3.0f, 1);
+    frame = WriteRingFrame(ring, 4.0f, 3);
+    Check(ring.BeginWrite() != uploadData && ring.BeginWrite() != frame, "gpu ring", "the writer gets the frame that was replaced");
+    Check(ring.BeginUpload(uploadData, uploadCount), "gpu ring", "the newest frame is uploaded");
+    Check(uploadData == frame && uploadData != skippedFrame && uploadCount == 3 && uploadData[0].m_particleTransform.Rot() == 4.0f, "gpu ring",
+          "the upload gets the newest frame");
+    Check(!ring.BeginUpload(uploadData, uploadCount), "gpu ring", "nothing is uploaded again until the next write");
+
+      // an emitter writing into the ring only hands over what fits in a frame
+    std::vector<shaderHandler::gPUData> emitterMemory(particleGPURing::c_frameCount * 100);
+    particleGPURing emitterRing(emitterMemory.data(), 100);
+    particleEmitter emitter(MakeFountain(200));
+    transform emitterTransform;
+    emitter.SetGPURing(&emitterRing);
+    emitter.RestartEmitter();
+
+    for (unsigned update = 0; update < 30; ++update)
+      emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+
+    unsigned gpuCount = 0;
+    emitter.GetLiveGPUData(gpuCount);
+    Check(gpuCount == 0, "gpu ring", "no gpu data is handed out besides the ring");
+    Check(emitterRing.BeginUpload(uploadData, uploadCount) && uploadCount == 100 && emitter.GetLiveParticleCount() > 100, "gpu ring",
+          "the emitter's frame is clamped to the ring's capacity");
+  }
+
+  /*!***********************************************************************************
+  \brief  The bounds of an emitter hold its live particles after it moved away from
+          where they spawned, and a negative random scale factor doesn't shrink them
+  *************************************************************************************/
+  void CheckBoundsCoverParticles()
+  {
+    particleEmitter emitter(MakeFountain(200));
+    transform emitterTransform;
+    emitter.RestartEmitter();
+
+    for (unsigned frame = 0; frame < 30; ++frame)
+      emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+
+    float bounds[4];
+    emitter.GetBounds(transform(vector4(1000.0f, 1000.0f, 0.0f)), bounds);
+
+    particleStorage& particles = emitter.GetParticles();
+    bool isInside = emitter.GetLiveParticleCount() > 0;
+    for (unsigned i = 0; i < emitter.GetLiveParticleCount(); ++i)
+    {
+      isInside = isInside && (particles.m_positionX[i] >= bounds[0]) && (particles.m_positionY[i] >= bounds[1]) &&
+                 (particles.m_positionX[i] <= bounds[2]) && (particles.m_positionY[i] <= bounds[3]);
+    }
+
+    Check(isInside, "emitter bounds", "the live particles are inside the bounds of a moved emitter");
+
+    emitterData fountain = MakeFountain(200);
+    fountain.m_randomScaleFactor = 0.5f;
+    particleEmitter positiveEmitter(fountain);
+    fountain.m_randomScaleFactor = -0.5f;
+    particleEmitter negativeEmitter(fountain);
+
+    float positiveBounds[4], negativeBounds[4];
+    positiveEmitter.GetBounds(emitterTransform, positiveBounds);
+    negativeEmitter.GetBounds(emitterTransform, negativeBounds);
+    Check(std::memcmp(positiveBounds, negativeBounds, sizeof(positiveBounds)) == 0, "emitter bounds", "the sign of the random scale factor doesn't matter");
+  }
+
+  /*!***********************************************************************************
+  \brief  A single instance of an instanced emitter writes the same gpu data as an
+          emitter with the definition, frame after frame
+  *************************************************************************************/
+  void CheckInstanceMatchesEmitter()
+  {
+    emitterDefinition definition = std::make_shared<const emitterData>(MakeFountain(300));
+    transform emitterTransform(vector4(2.0f, -1.0f, 0.0f));
+    emitterTransform.Rot(0.5f);
+
+    particleEmitter emitter(*definition);
+    emitter.RestartEmitter();
+
+    particleInstancedEmitter instancedEmitter(definition);
+    instancedEmitter.AddInstance(emitterTransform);
+
+    bool isSame = true;
+    for (unsigned frame = 0; frame < 120; ++frame)
+    {
+      emitter.UpdateParticleEmitter(1.0f / 60.0f, emitterTransform);
+      instancedEmitter.UpdateParticleEmitter(1.0f / 60.0f);
+
+      unsigned gpuCount = 0, instancedGPUCount = 0;
+      const shaderHandler::gPUData* gpuData = emitter.GetLiveGPUData(gpuCount);
+      const shaderHandler::gPUData* instancedGPUData = instancedEmitter.GetLiveGPUData(instancedGPUCount);
+      isSame = isSame && (gpuCount == instancedGPUCount);
+
+      for (unsigned i = 0; isSame && i < gpuCount; ++i)
+      {
+        const transform& particleTransform = gpuData[i].m_particleTransform;
+        const transform& instancedTransform = instancedGPUData[i].m_particleTransform;
+
+        isSame = (particleTransform.pos().x == instancedTransform.pos().x) && (particleTransform.pos().y == instancedTransform.pos().y) &&
+                 (particleTransform.pos().z == instancedTransform.pos().z) && (particleTransform.Rot() == instancedTransform.Rot()) &&
+                 (particleTransform.Scl().x == instancedTransform.Scl().x) && (gpuData[i].m_particleColor.x == instancedGPUData[i].m_particleColor.x) &&
+                 (gpuData[i].m_particleColor.y == instancedGPUData[i].m_particleColor.y) && (gpuData[i].m_particleColor.z == instancedGPUData[i].m_particleColor.z) &&
+                 (gpuData[i].m_particleColor.w == instancedGPUData[i].m_particleColor.w);
+      }
+    }
+
+    Check(instancedEmitter.GetLiveParticleCount() > 0, "instanced emitter", "the instance spawns particles");
+    Check(isSame, "instanced emitter", "a single instance writes the same gpu data as an emitter");
+  }
+}
+
+int main()
+{
+  CheckKernelsAgree();
+  CheckEmitterFills();
+  CheckAnalyticIsOptIn();
+  CheckInstanceMatchesEmitter();
+  CheckPackedGPUData();
+  CheckGPURing();
+  CheckBoundsCoverParticles();
+  CheckSelfInteraction();
+  CheckRingBuffer();
+  CheckDepthSort();
+
+  if (!s_failureCount)
+    std::printf("all checks passed\n");
+
+  return static_cast<int>(s_failureCount);
+}
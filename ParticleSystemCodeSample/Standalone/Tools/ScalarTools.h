@@ -0,0 +1,11 @@
+/*!****************************************************************************************
+\file       ScalarTools.h
+\author     agent
+\date       10/17/26
+\copyright  Copyright (c) 2026 agent. Written for this repository, not part of the original
+            DigiPen project.
+\brief
+Stand-in for the engine's scalar tools (the particle system doesn't use any of them
+anymore). Part of the standalone build of the particle system.
+******************************************************************************************/
+#pragma once